@@ -1,6 +1,7 @@
 #include <iostream>
 #include <functional>
 #include <algorithm>
+#include <optional>
 
 #include "libea.hpp"
 
@@ -46,32 +47,63 @@ distance(const City a, const City b)
 }
 
 // accumulate euclidean distances
-static auto fitness = [](auto first, auto last)
+struct Fitness
 {
-	double f = 0.0;
-
-	for (auto it = first; std::distance(it, last) > 2; it += 2)
+	template<typename InputIterator>
+	double operator()(InputIterator first, InputIterator last) const
 	{
-		f += distance(*it, *(it + 1));
+		double f = 0.0;
+
+		for (auto it = first; std::distance(it, last) > 2; it += 2)
+		{
+			f += distance(*it, *(it + 1));
+		}
+
+		return f;
 	}
 
-	return f;
+	// stops as soon as a route is longer than the cutoff, selection operators
+	// skip the remaining distances of losing routes
+	template<typename InputIterator>
+	std::optional<double> bounded(InputIterator first, InputIterator last, const double cutoff) const
+	{
+		double f = 0.0;
+
+		for (auto it = first; std::distance(it, last) > 2; it += 2)
+		{
+			f += distance(*it, *(it + 1));
+
+			if(f > cutoff)
+			{
+				return std::nullopt;
+			}
+		}
+
+		return f;
+	}
 };
 
+static const Fitness fitness = {};
+
 // print some details of the current population
 template<typename InputIterator, typename Fitness>
 static void statistic(InputIterator first, InputIterator last, Fitness fitness)
 {
-	std::cout << "mean fitness: " << ea::fitness::mean(first, last, fitness) << '\n';
-	std::cout << "median fitness: " << ea::fitness::median(first, last, fitness) << '\n';
+	// evaluate the population only once:
+	const ea::fitness::FitnessTable table(first, last, fitness);
+
+	const auto summary = ea::fitness::summary(table);
+
+	std::cout << "mean fitness: " << summary.mean << '\n';
+	std::cout << "median fitness: " << summary.median << '\n';
+	std::cout << "standard deviation: " << std::sqrt(summary.variance) << '\n';
+	std::cout << "best fitness: " << summary.min << '\n';
 
 	std::cout << "top 100..." << std::endl;
 
 	Routes top;
-	auto stream = ea::stream::make_mutable(first, last);
 
-	stream.select(ea::selection::Fittest<std::less<double>>(), 100, fitness)
-	      .take(std::back_inserter(top));
+	ea::selection::Fittest<std::less<double>>()(first, last, 100, table, std::back_inserter(top));
 
 	std::cout << "...average hamming distance: " << ea::diversity::avg_hamming_distance(begin(top), end(top)) << '\n';
 	std::cout << "...shannon entropy: " << ea::diversity::avg_shannon_entropy(begin(top), end(top)) << '\n';
@@ -95,16 +127,9 @@ static void print_route(InputIterator first, InputIterator last, Fitness fitness
 auto main() -> int
 {
 	// generate random routes:
-	Routes routes;
+	Routes routes(30000, Route(N_CITIES));
 
-	std::generate_n(std::back_inserter(routes), 30000, []()
-	{
-		Route route;
-
-		ea::random::fill_distinct_n_int(std::back_inserter(route), N_CITIES, 0, N_CITIES - 1);
-
-		return route;
-	});
+	ea::init::permutations(begin(routes), end(routes));
 
 	statistic(begin(routes), end(routes), fitness);
 
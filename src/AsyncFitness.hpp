@@ -0,0 +1,294 @@
+/***************************************************************************
+    begin........: October 2026
+    copyright....: Sebastian Fedrau
+    email........: sebastian.fedrau@gmail.com
+ ***************************************************************************/
+
+/***************************************************************************
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License v3 as published by
+    the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License v3 for more details.
+ ***************************************************************************/
+/**
+   @file AsyncFitness.hpp
+   @brief Asynchronous evaluation of expensive fitness functions.
+   @author Sebastian Fedrau <sebastian.fedrau@gmail.com>
+ */
+#ifndef EA_ASYNC_FITNESS_HPP
+#define EA_ASYNC_FITNESS_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ea::fitness
+{
+	/**
+	   @class ThreadPool
+	   @brief A fixed number of worker threads processing a bounded task queue.
+
+	   submit() blocks while the queue is full, which limits the number of
+	   evaluations waiting in memory.
+	 */
+	class ThreadPool
+	{
+		public:
+			/**
+			   @param threads number of worker threads
+			   @param capacity maximum number of queued tasks, 0 for four tasks per thread
+
+			   Throws std::invalid_argument if \p threads is zero.
+			 */
+			explicit ThreadPool(const size_t threads = default_threads(), const size_t capacity = 0)
+				: capacity(capacity > 0 ? capacity : threads * 4)
+			{
+				if(threads == 0)
+				{
+					throw std::invalid_argument("Number of threads cannot be zero.");
+				}
+
+				for(size_t i = 0; i < threads; ++i)
+				{
+					workers.emplace_back([this]()
+					{
+						run();
+					});
+				}
+			}
+
+			ThreadPool(const ThreadPool &) = delete;
+			ThreadPool &operator=(const ThreadPool &) = delete;
+
+			/**
+			   Finishes all queued tasks & joins the worker threads.
+			 */
+			~ThreadPool()
+			{
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+
+					stopped = true;
+				}
+
+				not_empty.notify_all();
+
+				for(auto &worker : workers)
+				{
+					worker.join();
+				}
+			}
+
+			/**
+			   @tparam F function object: R fun()
+			   @param fn task to execute
+			   @return future receiving the result of the task
+
+			   Queues a task. Blocks while the queue is full. Exceptions thrown by the
+			   task are rethrown by the returned future.
+			 */
+			template<typename F>
+			std::future<std::invoke_result_t<F &>> submit(F fn)
+			{
+				auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F &>()>>(std::move(fn));
+				auto future = task->get_future();
+
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+
+					not_full.wait(lock, [this]()
+					{
+						return tasks.size() < capacity;
+					});
+
+					tasks.emplace_back([task]()
+					{
+						(*task)();
+					});
+				}
+
+				not_empty.notify_one();
+
+				return future;
+			}
+
+			/**
+			   @return number of worker threads
+			 */
+			size_t size() const
+			{
+				return workers.size();
+			}
+
+			/**
+			   @return number of threads supported by the hardware, at least one
+			 */
+			static size_t default_threads()
+			{
+				return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+			}
+
+		private:
+			const size_t capacity;
+			std::vector<std::thread> workers;
+			std::deque<std::function<void()>> tasks;
+			std::mutex mutex;
+			std::condition_variable not_empty;
+			std::condition_variable not_full;
+			bool stopped = false;
+
+			void run()
+			{
+				for(;;)
+				{
+					std::function<void()> task;
+
+					{
+						std::unique_lock<std::mutex> lock(mutex);
+
+						not_empty.wait(lock, [this]()
+						{
+							return stopped || !tasks.empty();
+						});
+
+						if(tasks.empty())
+						{
+							return;
+						}
+
+						task = std::move(tasks.front());
+						tasks.pop_front();
+					}
+
+					not_full.notify_one();
+					task();
+				}
+			}
+	};
+
+	/**
+	   @class Async
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	   @brief Evaluates chromosomes on a thread pool.
+
+	   Async is a batch fitness function: selection operators, FitnessTable &
+	   streams hand it a range of chromosomes which is submitted to the pool
+	   and collected when all evaluations are finished. Streams additionally use
+	   submit() to start evaluating offspring while crossover & mutation are
+	   still running.
+
+	   Copies of the functor share the thread pool.
+	 */
+	template<typename Fitness>
+	class Async
+	{
+		public:
+			/**
+			   @param fn a fitness function
+			   @param threads number of worker threads
+			   @param capacity maximum number of queued evaluations, 0 for four per thread
+			 */
+			explicit Async(Fitness fn, const size_t threads = ThreadPool::default_threads(), const size_t capacity = 0)
+				: fn(fn)
+				, pool(std::make_shared<ThreadPool>(threads, capacity))
+			{}
+
+			/**
+			   @tparam PopulationIterator must meet the requirements of LegacyForwardIterator
+			   @param first iterator pointing to the first chromosome of a population
+			   @param last iterator pointing to the end (element after the last element) of a population
+			   @param out destination of the fitness values
+
+			   Evaluates the chromosomes of the range \p first to \p last on the thread pool
+			   & waits until all fitness values are written to \p out.
+			 */
+			template<typename PopulationIterator>
+			void operator()(PopulationIterator first, PopulationIterator last, double *out) const
+			{
+				std::vector<std::future<double>> futures;
+
+				for(auto it = first; it != last; ++it)
+				{
+					futures.push_back(pool->submit([this, it]()
+					{
+						return static_cast<double>(fn(std::begin(*it), std::end(*it)));
+					}));
+				}
+
+				// tasks refer to the population, wait for all of them before an exception is rethrown:
+				for(auto &future : futures)
+				{
+					future.wait();
+				}
+
+				for(auto &future : futures)
+				{
+					*out++ = future.get();
+				}
+			}
+
+			/**
+			   @tparam Chromosome chromosome type
+			   @param chromosome chromosome to evaluate
+			   @return future receiving the fitness value
+
+			   Starts evaluating a copy of \p chromosome on the thread pool.
+			 */
+			template<typename Chromosome>
+			std::shared_future<double> submit(const Chromosome &chromosome) const
+			{
+				return pool->submit([fn = fn, chromosome = Chromosome(chromosome)]() mutable
+				{
+					return static_cast<double>(fn(std::begin(chromosome), std::end(chromosome)));
+				}).share();
+			}
+
+		private:
+			Fitness fn;
+			std::shared_ptr<ThreadPool> pool;
+	};
+
+	/**
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	   @param fn a fitness function
+	   @param threads number of worker threads
+	   @param capacity maximum number of queued evaluations, 0 for four per thread
+	   @return new function object
+
+	   Wraps a fitness function to evaluate chromosomes on a thread pool.
+	 */
+	template<typename Fitness>
+	Async<Fitness> async(Fitness fn, const size_t threads = ThreadPool::default_threads(), const size_t capacity = 0)
+	{
+		return Async<Fitness>(fn, threads, capacity);
+	}
+
+	template<typename T>
+	struct is_async : std::false_type {};
+
+	template<typename Fitness>
+	struct is_async<Async<Fitness>> : std::true_type {};
+
+	/**
+	   @tparam T a type
+
+	   True if \p T is an asynchronous fitness function (see Async).
+	 */
+	template<typename T>
+	constexpr bool is_async_v = is_async<T>::value;
+}
+
+#endif
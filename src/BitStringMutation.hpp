@@ -38,11 +38,14 @@ namespace ea::mutation
 		public:
 			/**
 			   @param probability probability a gene is flipped
+			   @param sampling algorithm used to choose the flipped genes
 
 			   Throws std::invalid_argument if probability is out of range (0.0 <= p <= 1.0).
 			 */
-			explicit BitString(const double probability = 0.8)
+			explicit BitString(const double probability = 0.8,
+			                   const random::BernoulliSampling sampling = random::BernoulliSampling::automatic)
 				: probability(probability)
+				, sampling(sampling)
 			{
 				if(probability <= 0.0 || probability >= 1.0)
 				{
@@ -58,26 +61,39 @@ namespace ea::mutation
 			template<typename InputIterator>
 			void operator()(InputIterator first, InputIterator last) const
 			{
-				bool flipped = false;
-				const auto length = std::distance(first, last);
-				random::RandomEngine engine = random::default_engine();
-				std::uniform_real_distribution<double> dist(0.0, 1.0);
+				(*this)(first, last, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyInputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first points to the first element of a chromosome
+			   @param last points to the end of a chromosome
+			   @param eng random engine
+			 */
+			template<typename InputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, Engine &eng) const
+			{
+				auto g = first;
+				size_t position = 0;
 
-				while(!flipped && length > 0)
+				random::bernoulli_trials(std::distance(first, last), probability, eng, [&](const size_t offset)
 				{
-					for(auto g = first; g != last; ++g)
+					if(offset < position)
 					{
-						if(dist(engine) <= probability)
-						{
-							*g = !*g;
-							flipped = true;
-						}
+						g = first;
+						position = 0;
 					}
-				}
+
+					std::advance(g, offset - position);
+					position = offset;
+					*g = !*g;
+				}, sampling, true);
 			}
 
 		private:
 			const double probability;
+			const random::BernoulliSampling sampling;
 	};
 }
 
@@ -62,8 +62,36 @@ namespace ea::crossover
 			                  InputIterator last2,
 			                  OutputIterator result) const
 			{
-				const auto[length1, sep1] = separate(first1, last1);
-				const auto[length2, sep2] = separate(first2, last2);
+				return (*this)(first1, last1, first2, last2, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyInputIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first1 points to the first element of the first chromosome
+			   @param last1 points to the end of the first chromosome
+			   @param first2 points to the first element of the second chromosome
+			   @param last2 points to the end of the second chromosome
+			   @param result beginning of the destination range
+			   @param eng random engine
+			   @return number of offsprings written to \p result
+			   
+			   Combines two parents and generates new offspring.
+
+			   Throws std::length_error if the length of at least one chromosome is less than
+			   three and std::overflow_error if an overflow occurs.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			size_t operator()(InputIterator first1,
+			                  InputIterator last1,
+			                  InputIterator first2,
+			                  InputIterator last2,
+			                  OutputIterator result,
+			                  Engine &eng) const
+			{
+				const auto[length1, sep1] = separate(first1, last1, eng);
+				const auto[length2, sep2] = separate(first2, last2, eng);
 
 				append(first1, sep1, first2, sep2, length2, result);
 				append(first2, sep2, first1, sep1, length1, result);
@@ -75,9 +103,9 @@ namespace ea::crossover
 			template<typename InputIterator>
 			using difference_type = typename std::iterator_traits<InputIterator>::difference_type;
 
-			template<typename InputIterator>
+			template<typename InputIterator, typename Engine>
 			static std::tuple<difference_type<InputIterator>, difference_type<InputIterator>>
-			separate(InputIterator first, InputIterator last)
+			separate(InputIterator first, InputIterator last, Engine &eng)
 			{
 				const difference_type<InputIterator> length = std::distance(first, last);
 
@@ -86,7 +114,6 @@ namespace ea::crossover
 					throw std::length_error("Population too small.");
 				}
 
-				random::RandomEngine eng = random::default_engine();
 				std::uniform_int_distribution<difference_type<InputIterator>> dist(1, length - 2);
 
 				return std::make_tuple(length, dist(eng));
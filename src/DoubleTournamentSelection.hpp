@@ -28,10 +28,11 @@
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
+#include <cstdint>
 
 #include "Random.hpp"
-#include "Utils.hpp"
 #include "Fitness.hpp"
+#include "Utils.hpp"
 
 namespace ea::selection
 {
@@ -45,6 +46,9 @@ namespace ea::selection
 	class DoubleTournament
 	{
 		public:
+			/*! Fitness values can be passed as fitness::FitnessTable (see fitness::accepts_fitness_table_v). */
+			static constexpr bool accepts_fitness_table = true;
+
 			/**
 			   @param Q number of random opponents each individual is compared to
 
@@ -76,74 +80,219 @@ namespace ea::selection
 			template<typename InputIterator, typename Fitness, typename OutputIterator>
 			void operator()(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
 			{
-				const auto length = std::distance(first, last);
+				select_indices(first, last, N, fitness, utils::make_gather_iterator(first, result));
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from a population and copies them to \p result.
+
+			   Throws std::length_error if \p Q or \p N exceeds the population size.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, fitness, utils::make_gather_iterator(first, result), eng);
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from an evaluated population and copies them to \p result.
+
+			   Throws std::length_error if \p Q or \p N exceeds the population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result) const
+			{
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result));
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from an evaluated population and copies them to \p result.
+
+			   Throws std::length_error if \p Q or \p N exceeds the population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result), eng);
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from a population and writes their indices to \p result.
+
+			   Throws std::length_error if \p Q or \p N exceeds the population size.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
+			{
+				select_indices(first, last, N, fitness, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from a population and writes their indices to \p result.
+
+			   Throws std::length_error if \p Q or \p N exceeds the population size.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator, typename Engine>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result, Engine &eng) const
+			{
+				// each individual competes, so all fitness values are needed:
+				select_indices(first, last, N, fitness::FitnessTable(first, last, fitness), result, eng);
+			}
 
-				if(length < 0 || static_cast<typename std::make_unsigned<difference_type<InputIterator>>::type>(length) <= Q)
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from an evaluated population and writes their indices to \p result.
+
+			   Throws std::length_error if \p Q or \p N exceeds the population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result) const
+			{
+				select_indices(first, last, N, table, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from an evaluated population and writes their indices to \p result.
+
+			   Throws std::length_error if \p Q or \p N exceeds the population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result, Engine &eng) const
+			{
+				fitness::check_table_size(table, std::distance(first, last));
+
+				const size_t length = table.size();
+
+				if(length <= Q)
 				{
 					throw std::length_error("Q exceeds population size.");
 				}
 
-				if(N > 0 && N >= static_cast<typename std::make_unsigned<difference_type<InputIterator>>::type>(length))
+				if(N > 0 && N >= length)
 				{
 					throw std::length_error("N exceeds population size.");
 				}
 
-				std::vector<Score<InputIterator>> indeces;
+				std::vector<Score> scores(length);
+				const uint64_t seed = random::bits64(eng);
 
 				#pragma omp parallel
 				{
-					std::vector<Score<InputIterator>> subset;
-					auto fitness_by_index = fitness::memoize_fitness_by_index<InputIterator>(fitness);
+					std::vector<size_t> opponents(Q);
 
 					#pragma omp for
-					for(difference_type<InputIterator> i = 0; i < length; ++i)
+					for(size_t i = 0; i < length; ++i)
 					{
-						Score<InputIterator> score = { i, 0 };
-
-						std::vector<difference_type<InputIterator>> opponents(Q);
+						// each contest draws from its own sub-stream, results don't depend on the number of threads:
+						random::RandomEngine contest_eng(random::derive_seed(seed, i));
 
-						random::fill_distinct_n_int(begin(opponents), Q, static_cast<difference_type<InputIterator>>(0), length - 1);
+						random::fill_distinct_n_int(begin(opponents), Q, static_cast<size_t>(0), length - 1, contest_eng);
 
-						std::for_each(begin(opponents), end(opponents), [&](difference_type<InputIterator> j)
+						scores[i] = { i, static_cast<size_t>(std::count_if(begin(opponents), end(opponents), [&table, i](const size_t j)
 						{
-							if(Compare()(fitness_by_index(first, i), fitness_by_index(first, j)))
-							{
-								++score.value;
-							}
-						});
-
-						subset.push_back(score);
+							return Compare()(table[i], table[j]);
+						})) };
 					}
-
-					#pragma omp critical
-					std::move(begin(subset), end(subset), std::back_inserter(indeces));
 				}
 
-				std::sort(begin(indeces), end(indeces));
+				if(N > 0)
+				{
+					std::nth_element(begin(scores), begin(scores) + N - 1, end(scores));
+					std::sort(begin(scores), begin(scores) + N);
+				}
 
-				std::transform(begin(indeces), begin(indeces) + N, result, [&](auto &score)
+				std::transform(begin(scores), begin(scores) + N, result, [](auto &score)
 				{
-					return *(first + score.offset);
+					return score.offset;
 				});
 			}
 
 		private:
-			template<typename InputIterator>
-			using difference_type = typename std::iterator_traits<InputIterator>::difference_type;
+			const size_t Q;
 
-			template<typename InputIterator>
+			// orders by victories, ties by position in the population:
 			struct Score
 			{
-				difference_type<InputIterator> offset;
+				size_t offset;
 				size_t value;
 
 				bool operator<(const struct Score& rhs) const
 				{
-					return value > rhs.value;
+					return value > rhs.value || (value == rhs.value && offset < rhs.offset);
 				}
 			};
-
-			const size_t Q;
 	};
 }
 
@@ -65,6 +65,34 @@ namespace ea::crossover
 				          InputIterator first2,
 				          InputIterator last2,
 				          OutputIterator result) const
+			{
+				return (*this)(first1, last1, first2, last2, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first1 points to the first element of the first chromosome
+			   @param last1 points to the end of the first chromosome
+			   @param first2 points to the first element of the second chromosome
+			   @param last2 points to the end of the second chromosome
+			   @param result beginning of the destination range
+			   @param eng random engine
+			   @return number of offsprings written to \p result
+
+			   Combines two parents and generates a single offspring.
+
+			   Throws std::length_error or std::logic_error if the genes of the parent
+			   chromosomes aren't the same.
+			*/
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			size_t operator()(InputIterator first1,
+				          InputIterator last1,
+				          InputIterator first2,
+				          InputIterator last2,
+				          OutputIterator result,
+				          Engine &eng) const
 			{
 				const difference_type<InputIterator> length = std::distance(first1, last1);
 
@@ -79,7 +107,6 @@ namespace ea::crossover
 				{
 					NeighborMap map = build_map(first1, last1, first2, last2);
 
-					random::RandomEngine eng = random::default_engine();
 					std::uniform_int_distribution<difference_type<InputIterator>> dist(0, length - 1);
 					difference_type<InputIterator> offset = dist(eng);
 
@@ -173,8 +200,8 @@ namespace ea::crossover
 				});
 			}
 
-			template<typename InputIterator>
-			static InputIterator best_neighbor(NeighborMap map, random::RandomEngine &eng, InputIterator first, InputIterator last)
+			template<typename InputIterator, typename Engine>
+			static InputIterator best_neighbor(NeighborMap map, Engine &eng, InputIterator first, InputIterator last)
 			{
 				std::vector<InputIterator> shuffled;
 
@@ -26,12 +26,17 @@
 #include <functional>
 #include <algorithm>
 #include <iterator>
-#include <map>
+#include <memory>
+#include <atomic>
+#include <cstdint>
 #include <tuple>
+#include <optional>
 #include <vector>
 #include <limits>
 #include <cfenv>
+#include <cmath>
 #include <stdexcept>
+#include <type_traits>
 
 namespace ea::fitness
 {
@@ -52,17 +57,165 @@ namespace ea::fitness
 	using FitnessFunction = std::function<double(ChromosomeIterator<PopulationIterator>,
 	                                             ChromosomeIterator<PopulationIterator>)>;
 
+	/**
+	   @struct Change
+	   @tparam T gene type
+	   @brief A gene overwritten by a mutation operator.
+	 */
+	template<typename T>
+	struct Change
+	{
+		/*! Position of the gene. */
+		size_t offset;
+		/*! Value of the gene before the mutation. */
+		T value;
+	};
+
+	template<typename Fitness, typename ChromosomeIterator, typename = void>
+	struct has_delta : std::false_type {};
+
+	template<typename Fitness, typename ChromosomeIterator>
+	struct has_delta<Fitness,
+	                 ChromosomeIterator,
+	                 std::void_t<decltype(std::declval<Fitness &>().delta(
+	                       std::declval<ChromosomeIterator>(),
+	                       std::declval<ChromosomeIterator>(),
+	                       std::declval<const std::vector<Change<typename std::iterator_traits<ChromosomeIterator>::value_type>> &>(),
+	                       std::declval<double>()))>> : std::true_type {};
+
+	/**
+	   @tparam Fitness fitness function object
+	   @tparam ChromosomeIterator iterator type pointing to a gene
+
+	   True if \p Fitness updates the fitness of a mutated chromosome incrementally:
+	   double delta(ChromosomeIterator first, ChromosomeIterator last, const std::vector<Change<Gene>> &changes, double fitness)
+
+	   \p first and \p last describe the mutated chromosome, \p changes the overwritten genes
+	   and \p fitness the fitness before the mutation.
+	 */
+	template<typename Fitness, typename ChromosomeIterator>
+	constexpr bool has_delta_v = has_delta<Fitness, ChromosomeIterator>::value;
+
+	template<typename Fitness, typename ChromosomeIterator, typename = void>
+	struct has_bounded : std::false_type {};
+
+	template<typename Fitness, typename ChromosomeIterator>
+	struct has_bounded<Fitness,
+	                   ChromosomeIterator,
+	                   std::enable_if_t<std::is_convertible_v<decltype(std::declval<Fitness &>().bounded(
+	                         std::declval<ChromosomeIterator>(),
+	                         std::declval<ChromosomeIterator>(),
+	                         std::declval<double>())), std::optional<double>>>> : std::true_type {};
+
+	/**
+	   @tparam Fitness fitness function object
+	   @tparam ChromosomeIterator iterator type pointing to a gene
+
+	   True if \p Fitness can stop evaluating a chromosome that cannot beat a known fitness:
+	   std::optional<double> bounded(ChromosomeIterator first, ChromosomeIterator last, double cutoff)
+
+	   The function returns the exact fitness or an empty value if the chromosome is
+	   known to be worse than \p cutoff, e.g. because a partial sum exceeds it when
+	   the fitness is minimized. "Worse" has to agree with the comparison used by the
+	   selection operator. Tournaments and Fittest selection use this protocol when
+	   available.
+	 */
+	template<typename Fitness, typename ChromosomeIterator>
+	constexpr bool has_bounded_v = has_bounded<Fitness, ChromosomeIterator>::value;
+
+	/**
+	   @tparam Fitness fitness function object
+	   @tparam PopulationIterator iterator type pointing to a chromosome
+
+	   True if \p Fitness evaluates a range of chromosomes at once:
+	   void fun(PopulationIterator first, PopulationIterator last, double *out)
+	 */
+	template<typename Fitness, typename PopulationIterator>
+	constexpr bool is_batch_fitness_v = std::is_invocable_v<Fitness &, PopulationIterator, PopulationIterator, double *>;
+
+	/*! Maximum number of chromosomes passed to a batch fitness function at once. */
+	const size_t BATCH_SIZE = 64;
+
+	template<typename Fitness, typename = void>
+	struct batch_size : std::integral_constant<size_t, BATCH_SIZE> {};
+
+	template<typename Fitness>
+	struct batch_size<Fitness, std::void_t<decltype(Fitness::batch_size)>>
+		: std::integral_constant<size_t, Fitness::batch_size> {};
+
+	/**
+	   @tparam Fitness batch fitness function object
+
+	   Maximum number of chromosomes FitnessTable passes to \p Fitness at once. A
+	   batch function may declare a static constexpr size_t member named batch_size,
+	   e.g. std::numeric_limits<size_t>::max() to receive the whole population in a
+	   single call. Defaults to BATCH_SIZE.
+	 */
+	template<typename Fitness>
+	constexpr size_t batch_size_v = batch_size<Fitness>::value;
+
+	/**
+	   @class Batch
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	   @brief Adapts a fitness function evaluating a single chromosome to the batch interface.
+	 */
+	template<typename Fitness>
+	class Batch
+	{
+		public:
+			/**
+			   @param fn a fitness function
+			 */
+			explicit Batch(Fitness fn)
+				: fn(fn)
+			{}
+
+			/**
+			   @tparam PopulationIterator must meet the requirements of LegacyInputIterator
+			   @param first iterator pointing to the first chromosome of a population
+			   @param last iterator pointing to the end (element after the last element) of a population
+			   @param out destination of the fitness values
+
+			   Writes the fitness of each chromosome in the range \p first to \p last to \p out.
+			 */
+			template<typename PopulationIterator>
+			void operator()(PopulationIterator first, PopulationIterator last, double *out) const
+			{
+				for(auto it = first; it != last; ++it)
+				{
+					*out++ = fn(std::begin(*it), std::end(*it));
+				}
+			}
+
+		private:
+			// mutable, so function objects with a non-const call operator can be wrapped:
+			mutable Fitness fn;
+	};
+
+	/**
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	   @param fn a fitness function
+	   @return new function object
+
+	   Adapts a fitness function evaluating a single chromosome to the batch interface.
+	 */
+	template<typename Fitness>
+	Batch<Fitness> batch(Fitness fn)
+	{
+		return Batch<Fitness>(fn);
+	}
+
 	/**
 	   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
 	   @param fn a fitness function
 	   @return new function object
 
 	   Wraps a fitness function & returns a new function object to get the fitness
 	   of a chromosome by index.
 	 */	
-	template<typename PopulationIterator>
-	std::function<double(PopulationIterator, const size_t)>
-	fitness_by_index(FitnessFunction<PopulationIterator> fn)
+	template<typename PopulationIterator, typename Fitness = FitnessFunction<PopulationIterator>>
+	auto fitness_by_index(Fitness fn)
 	{
 		return [fn](PopulationIterator first, const size_t index)
 		{
@@ -75,20 +228,31 @@ namespace ea::fitness
 	/**
 	   @class MemoizeFitnessByIndex
 	   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
 	   @brief A functor to get the fitness of a chromosome by index. The fitness value
 	          is cached for each index.
+
+	   Fitness values are stored in an array indexed by the chromosome's position,
+	   a bitmap tracks the computed values. Copies of the functor share the cache.
+
+	   A functor created with a population size can be used by multiple threads
+	   at the same time. Without size the cache grows on demand & must not be
+	   shared between threads.
 	 */
-	template<typename PopulationIterator>
+	template<typename PopulationIterator, typename Fitness = FitnessFunction<PopulationIterator>>
 	class MemoizeFitnessByIndex
 	{
 		public:
 			/**
 			   @param fn a fitness functions
+			   @param size population size, 0 if the cache should grow on demand
 
 			   Creates the functor and wraps the given fitness function.
 			 */
-			explicit MemoizeFitnessByIndex(FitnessFunction<PopulationIterator> fn)
-				: fn(fitness_by_index<PopulationIterator>(fn))
+			explicit MemoizeFitnessByIndex(Fitness fn, const size_t size = 0)
+				: fn(fn)
+				, cache(std::make_shared<Cache>(size))
+				, fixed(size > 0)
 			{}
 
 			/**
@@ -97,47 +261,349 @@ namespace ea::fitness
 			   @return fitness of the chromosome at the specifed position
 
 			   Returns and caches the fitness of a chromosome at the given position.
+			   Indices exceeding the size of a fixed cache are not cached.
 			 */
 			double operator()(PopulationIterator population, const size_t index)
+			{
+				if(index >= cache->size())
+				{
+					if(fixed)
+					{
+						return evaluate(population, index);
+					}
+
+					cache->resize(std::max(index + 1, cache->size() * 2));
+				}
+
+				return cache->get(index, [&]()
+				{
+					return evaluate(population, index);
+				});
+			}
+
+			/**
+			   @tparam F fitness function object providing a bounded function (see has_bounded_v)
+			   @param population iterator pointing to the first chromosome of a population
+			   @param index index of the desired chromosome
+			   @param cutoff fitness the chromosome is compared to
+			   @return fitness of the chromosome or an empty value if it's worse than \p cutoff
+
+			   Returns the cached fitness of a chromosome or evaluates it with the bounded
+			   function of the wrapped fitness function. Only exact values are cached.
+			 */
+			template<typename F = Fitness>
+			std::enable_if_t<has_bounded_v<F, decltype(std::begin(*std::declval<PopulationIterator>()))>, std::optional<double>>
+			bounded(PopulationIterator population, const size_t index, const double cutoff)
 			{
 				double fitness;
-				auto found = cache.find(index);
 
-				if(found == end(cache))
+				if(index < cache->size() && cache->find(index, fitness))
 				{
-					fitness = fn(population, index);
-					cache[index] = fitness;
+					return fitness;
 				}
-				else
+
+				auto &chromosome = *(population + index);
+				const std::optional<double> bounded = fn.bounded(std::begin(chromosome), std::end(chromosome), cutoff);
+
+				if(bounded && index < cache->size())
 				{
-					fitness = found->second;
+					cache->store(index, *bounded);
 				}
 
-				return fitness;
+				return bounded;
 			}
 
 		private:
-			const std::function<double(PopulationIterator, const size_t)> fn;
-			std::map<size_t, double> cache;
+			class Cache
+			{
+				public:
+					explicit Cache(const size_t size)
+					{
+						resize(size);
+					}
+
+					size_t size() const
+					{
+						return values.size();
+					}
+
+					void resize(const size_t size)
+					{
+						const size_t count = (size + 63) / 64;
+						auto new_claimed = std::make_unique<std::atomic<uint64_t>[]>(count);
+						auto new_valid = std::make_unique<std::atomic<uint64_t>[]>(count);
+
+						for(size_t i = 0; i < count; ++i)
+						{
+							new_claimed[i].store(i < words ? claimed[i].load() : 0);
+							new_valid[i].store(i < words ? valid[i].load() : 0);
+						}
+
+						values.resize(size);
+						claimed = std::move(new_claimed);
+						valid = std::move(new_valid);
+						words = count;
+					}
+
+					template<typename F>
+					double get(const size_t index, F compute)
+					{
+						double fitness;
+
+						if(!find(index, fitness))
+						{
+							fitness = compute();
+							store(index, fitness);
+						}
+
+						return fitness;
+					}
+
+					bool find(const size_t index, double &fitness) const
+					{
+						if(valid[index / 64].load(std::memory_order_acquire) & (uint64_t(1) << (index % 64)))
+						{
+							fitness = values[index];
+
+							return true;
+						}
+
+						return false;
+					}
+
+					void store(const size_t index, const double fitness)
+					{
+						const size_t word = index / 64;
+						const uint64_t bit = uint64_t(1) << (index % 64);
+
+						// only the first thread claiming the slot stores the value:
+						if(!(claimed[word].fetch_or(bit, std::memory_order_relaxed) & bit))
+						{
+							values[index] = fitness;
+							valid[word].fetch_or(bit, std::memory_order_release);
+						}
+					}
+
+				private:
+					std::vector<double> values;
+					std::unique_ptr<std::atomic<uint64_t>[]> claimed;
+					std::unique_ptr<std::atomic<uint64_t>[]> valid;
+					size_t words = 0;
+			};
+
+			Fitness fn;
+			std::shared_ptr<Cache> cache;
+			const bool fixed;
+
+			// non-const, so mutable function objects can be wrapped:
+			double evaluate(PopulationIterator population, const size_t index)
+			{
+				auto &chromosome = *(population + index);
+
+				return fn(std::begin(chromosome), std::end(chromosome));
+			}
 	};
 
 	/**
 	   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
 	   @param fn a fitness function
+	   @param size population size, 0 if the cache should grow on demand
 	   @return new function object
 
 	   Wraps a fitness function & returns a new function object to get the fitness
 	   of a chromosome by index. The fitness is cached for each index.
 	 */	
-	template<typename PopulationIterator>
-	std::function<double(PopulationIterator, const size_t)>
-	memoize_fitness_by_index(FitnessFunction<PopulationIterator> fn)
+	template<typename PopulationIterator, typename Fitness = FitnessFunction<PopulationIterator>>
+	MemoizeFitnessByIndex<PopulationIterator, Fitness>
+	memoize_fitness_by_index(Fitness fn, const size_t size = 0)
+	{
+		return MemoizeFitnessByIndex<PopulationIterator, Fitness>(fn, size);
+	}
+
+	/**
+	   @class FitnessTable
+	   @brief Fitness values of a population, stored in the order of the chromosomes.
+
+	   Evaluate a population once & pass the table to selection operators and
+	   statistic functions instead of the fitness function.
+	 */
+	class FitnessTable
+	{
+		public:
+			/**
+			   Creates an empty table.
+			 */
+			FitnessTable() = default;
+
+			/**
+			   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(PopulationIterator first, PopulationIterator last, double *out)
+			   @param first iterator pointing to the first chromosome of a population
+			   @param last iterator pointing to the end (element after the last element) of a population
+			   @param fn a fitness function
+
+			   Evaluates all chromosomes of the range \p first to \p last in parallel.
+			   Batch functions are called with up to batch_size_v<Fitness> chromosomes at
+			   once. A population fitting into a single batch is passed outside of a
+			   parallel region, so the batch function may use threads of its own and its
+			   exceptions reach the caller.
+			 */
+			template<typename PopulationIterator, typename Fitness>
+			FitnessTable(PopulationIterator first, PopulationIterator last, Fitness fn)
+				: values(std::distance(first, last))
+			{
+				using size_type = typename std::make_unsigned<typename std::iterator_traits<PopulationIterator>::difference_type>::type;
+
+				const size_type length = values.size();
+
+				if constexpr(is_batch_fitness_v<Fitness, PopulationIterator>)
+				{
+					constexpr size_t size = batch_size_v<Fitness>;
+					const size_type batches = length > 0 ? (length - 1) / size + 1 : 0;
+
+					if(batches == 1)
+					{
+						fn(first, last, values.data());
+					}
+					else
+					{
+						#pragma omp parallel for
+						for(size_type i = 0; i < batches; ++i)
+						{
+							const size_type offset = i * size;
+							const size_type count = std::min<size_type>(size, length - offset);
+
+							fn(first + offset, first + offset + count, values.data() + offset);
+						}
+					}
+				}
+				else
+				{
+					#pragma omp parallel for
+					for(size_type i = 0; i < length; ++i)
+					{
+						auto &chromosome = *(first + i);
+
+						values[i] = fn(std::begin(chromosome), std::end(chromosome));
+					}
+				}
+			}
+
+			/**
+			   @param values fitness values
+
+			   Creates a table from already known fitness values.
+			 */
+			explicit FitnessTable(std::vector<double> values)
+				: values(std::move(values))
+			{}
+
+			/**
+			   @param index index of a chromosome
+			   @return fitness of the chromosome at the specified position
+			 */
+			double operator[](const size_t index) const
+			{
+				return values[index];
+			}
+
+			/**
+			   @return number of stored fitness values
+			 */
+			size_t size() const
+			{
+				return values.size();
+			}
+
+			/**
+			   @return iterator to the first fitness value
+			 */
+			std::vector<double>::const_iterator begin() const
+			{
+				return values.begin();
+			}
+
+			/**
+			   @return iterator to the end of the fitness values
+			 */
+			std::vector<double>::const_iterator end() const
+			{
+				return values.end();
+			}
+
+			/**
+			   @return pointer to the first fitness value
+			 */
+			const double *data() const
+			{
+				return values.data();
+			}
+
+		private:
+			std::vector<double> values;
+	};
+
+	/**
+	   @param table fitness values of a population
+	   @param size expected number of fitness values
+
+	   Throws std::length_error if the table doesn't contain \p size fitness values.
+	 */
+	inline void check_table_size(const FitnessTable &table, const size_t size)
+	{
+		if(table.size() != size)
+		{
+			throw std::length_error("Fitness table doesn't match population size.");
+		}
+	}
+
+	template<typename Operator, typename = void>
+	struct accepts_fitness_table : std::false_type {};
+
+	template<typename Operator>
+	struct accepts_fitness_table<Operator, std::void_t<decltype(Operator::accepts_fitness_table)>>
+		: std::integral_constant<bool, Operator::accepts_fitness_table> {};
+
+	/**
+	   @tparam Operator selection operator
+
+	   True if \p Operator declares a static constexpr bool member named
+	   accepts_fitness_table set to true, i.e. it can be called with a FitnessTable
+	   instead of a fitness function. Streams pass stored fitness values only to
+	   such operators.
+	 */
+	template<typename Operator>
+	constexpr bool accepts_fitness_table_v = accepts_fitness_table<Operator>::value;
+
+	/**
+	   @param table fitness values of a population
+	   @return mean fitness
+
+	   Calculates the mean fitness value of an evaluated population.
+
+	   Throws std::overflow_error if the total fitness exceeds the supported maximum.
+	 */
+	inline double mean(const FitnessTable &table)
 	{
-		return MemoizeFitnessByIndex<PopulationIterator>(fn);
+		std::feclearexcept(FE_OVERFLOW);
+
+		const double sum = std::accumulate(table.begin(), table.end(), 0.0);
+
+		if(std::fetestexcept(FE_OVERFLOW))
+		{
+			throw std::overflow_error("Arithmetic overflow.");
+		}
+
+		return table.size() > 0 ? sum / table.size()
+		                        : std::numeric_limits<double>::quiet_NaN();
 	}
 
 	/**
 	   @tparam PopulationIterator must meet the requirements of LegacyInputIterator
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	                   or batch function: void fun(PopulationIterator first, PopulationIterator last, double *out)
 	   @param first iterator pointing to the first chromosome of a population
 	   @param last iterator pointing to the end (element after the last element) of a population
 	   @param fn a fitness function
@@ -148,31 +614,57 @@ namespace ea::fitness
 
 	   Throws std::overflow_error if the total fitness exceeds the supported maximum.
 	 */	
-	template<typename PopulationIterator>
-	double mean(PopulationIterator first, PopulationIterator last, FitnessFunction<PopulationIterator> fn)
+	template<typename PopulationIterator, typename Fitness = FitnessFunction<PopulationIterator>>
+	double mean(PopulationIterator first, PopulationIterator last, Fitness fn)
 	{
-		const auto distance = std::distance(first, last);
-
-		std::feclearexcept(FE_OVERFLOW);
-
-		const double sum = std::accumulate(first, last, 0.0, [&fn](double sum, auto chromosome)
+		if constexpr(is_batch_fitness_v<Fitness, PopulationIterator>)
+		{
+			return mean(FitnessTable(first, last, fn));
+		}
+		else
 		{
-			sum += fn(begin(chromosome), end(chromosome));
+			const auto distance = std::distance(first, last);
 
-			if(std::fetestexcept(FE_OVERFLOW))
+			std::feclearexcept(FE_OVERFLOW);
+
+			const double sum = std::accumulate(first, last, 0.0, [&fn](double sum, auto &chromosome)
 			{
-				throw std::overflow_error("Arithmetic overflow.");
-			}
+				sum += fn(begin(chromosome), end(chromosome));
 
-			return sum;
-		});
+				if(std::fetestexcept(FE_OVERFLOW))
+				{
+					throw std::overflow_error("Arithmetic overflow.");
+				}
+
+				return sum;
+			});
+
+			return distance > 0 ? sum / distance
+			                    : std::numeric_limits<double>::quiet_NaN();
+		}
+	}
+
+	/**
+	   @param table fitness values of a population
+	   @return median fitness
+
+	   Calculates the median fitness value of an evaluated population.
+	 */
+	inline double median(const FitnessTable &table)
+	{
+		std::vector<double> values(table.begin(), table.end());
+		auto middle = begin(values) + values.size() / 2;
 
-		return distance > 0 ? sum / distance
-		                    : std::numeric_limits<double>::quiet_NaN();
+		std::nth_element(begin(values), middle, end(values));
+
+		return values.size() > 0 ? *middle
+		                         : std::numeric_limits<double>::quiet_NaN();
 	}
 
 	/**
 	   @tparam PopulationIterator must meet the requirements of LegacyInputIterator
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	                   or batch function: void fun(PopulationIterator first, PopulationIterator last, double *out)
 	   @param first iterator pointing to the first chromosome of a population
 	   @param last iterator pointing to the end (element after the last element) of a population
 	   @param fn a fitness function
@@ -181,25 +673,71 @@ namespace ea::fitness
 	   Calculates the median fitness value of a population by applying the given fitness
 	   function \p fn to all chromosomes of the range \p first to \p last.
 	 */	
-	template<typename PopulationIterator>
-	double median(PopulationIterator first, PopulationIterator last, FitnessFunction<PopulationIterator> fn)
+	template<typename PopulationIterator, typename Fitness = FitnessFunction<PopulationIterator>>
+	double median(PopulationIterator first, PopulationIterator last, Fitness fn)
 	{
-		std::vector<double> values;
+		if constexpr(is_batch_fitness_v<Fitness, PopulationIterator>)
+		{
+			return median(FitnessTable(first, last, fn));
+		}
+		else
+		{
+			std::vector<double> values;
+
+			std::for_each(first, last, [&values, &fn](auto &chromosome)
+			{
+				values.push_back(fn(begin(chromosome), end(chromosome)));
+			});
+
+			std::sort(begin(values), end(values));
+
+			return values.size() > 0 ? values[(end(values) - begin(values)) / 2]
+			                         : std::numeric_limits<double>::quiet_NaN();
+		}
+	}
 
-		std::for_each(first, last, [&values, &fn](auto chromosome)
+	/**
+	   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam Compare function to compare fitness values
+	   @param first iterator pointing to the first chromosome of a population
+	   @param last iterator pointing to the end (element after the last element) of a population
+	   @param table fitness values of the population
+	   @return iterator to the fittest chromosome & the related fitness value
+
+	   Finds the fittest chromosome of an evaluated population.
+
+	   Throws std::length_error if the table doesn't match the population size.
+	 */
+	template<typename PopulationIterator, typename Compare = std::greater<double>>
+	std::tuple<PopulationIterator, double> fittest(PopulationIterator first, PopulationIterator last, const FitnessTable &table)
+	{
+		check_table_size(table, std::distance(first, last));
+
+		size_t index = 0;
+		double fitness = 0.0;
+
+		if(table.size() > 0)
 		{
-			values.push_back(fn(begin(chromosome), end(chromosome)));
-		});
+			fitness = table[0];
 
-		std::sort(begin(values), end(values));
+			for(size_t i = 1; i < table.size(); ++i)
+			{
+				if(Compare()(table[i], fitness))
+				{
+					index = i;
+					fitness = table[i];
+				}
+			}
+		}
 
-		return values.size() > 0 ? values[(end(values) - begin(values)) / 2]
-		                         : std::numeric_limits<double>::quiet_NaN();
+		return std::make_tuple(first + index, fitness);
 	}
 
 	/**
 	   @tparam PopulationIterator must meet the requirements of LegacyInputIterator
 	   @tparam Compare function to compare fitness values
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	                   or batch function: void fun(PopulationIterator first, PopulationIterator last, double *out)
 	   @param first iterator pointing to the first chromosome of a population
 	   @param last iterator pointing to the end (element after the last element) of a population
 	   @param fn a fitness function
@@ -208,33 +746,297 @@ namespace ea::fitness
 	   Finds the fittest chromosome by applying the function \p fn to all chromosomes
 	   of the range \p first to \p last.
 	 */	
-	template<typename PopulationIterator, typename Compare = std::greater<double>>
-	std::tuple<PopulationIterator, double> fittest(PopulationIterator first, PopulationIterator last, FitnessFunction<PopulationIterator> fn)
+	template<typename PopulationIterator, typename Compare = std::greater<double>, typename Fitness = FitnessFunction<PopulationIterator>>
+	std::tuple<PopulationIterator, double> fittest(PopulationIterator first, PopulationIterator last, Fitness fn)
 	{
-		PopulationIterator fittest = first;
-		double fitness = 0.0;
+		if constexpr(is_batch_fitness_v<Fitness, PopulationIterator>)
+		{
+			return fittest<PopulationIterator, Compare>(first, last, FitnessTable(first, last, fn));
+		}
+		else
+		{
+			PopulationIterator fittest = first;
+			double fitness = 0.0;
+
+			if(fittest != last)
+			{
+				fitness = fn(begin(*fittest), end(*fittest));
+
+				auto opponent = first;
+
+				while(++opponent != last)
+				{
+					double new_fitness = fn(begin(*opponent), end(*opponent));
+
+					if(Compare()(new_fitness, fitness))
+					{
+						fittest = opponent;
+						fitness = new_fitness;
+					}
+				}
+			}
 
-		if(fittest != last)
+			return std::make_tuple(fittest, fitness);
+		}
+	}
+
+	/**
+	   @struct Summary
+	   @brief Statistics of an evaluated population.
+
+	   All values are NaN if the population is empty.
+	 */
+	struct Summary
+	{
+		/*! Number of chromosomes. */
+		size_t count = 0;
+		/*! Mean fitness. */
+		double mean = std::numeric_limits<double>::quiet_NaN();
+		/*! Population variance of the fitness values. */
+		double variance = std::numeric_limits<double>::quiet_NaN();
+		/*! Lowest fitness. */
+		double min = std::numeric_limits<double>::quiet_NaN();
+		/*! Highest fitness. */
+		double max = std::numeric_limits<double>::quiet_NaN();
+		/*! Index of the first chromosome with the lowest fitness. */
+		size_t argmin = 0;
+		/*! Index of the first chromosome with the highest fitness. */
+		size_t argmax = 0;
+		/*! Median fitness (see median()). */
+		double median = std::numeric_limits<double>::quiet_NaN();
+		/*! Requested quantiles in the order of the given probabilities. */
+		std::vector<double> quantiles;
+	};
+
+	/*! Number of fitness values a thread reduces at once when building a summary. */
+	const size_t SUMMARY_BLOCK_SIZE = 4096;
+
+	namespace detail
+	{
+		// compensated (Neumaier) summation:
+		struct CompensatedSum
 		{
-			fitness = fn(begin(*fittest), end(*fittest));
+			double sum = 0.0;
+			double compensation = 0.0;
 
-			auto opponent = first;
+			void add(const double value)
+			{
+				const double t = sum + value;
 
-			while(++opponent != last)
+				if(std::abs(sum) >= std::abs(value))
+				{
+					compensation += (sum - t) + value;
+				}
+				else
+				{
+					compensation += (value - t) + sum;
+				}
+
+				sum = t;
+			}
+
+			double total() const
 			{
-				double new_fitness = fn(begin(*opponent), end(*opponent));
+				return sum + compensation;
+			}
+		};
+	}
+
+	/**
+	   @param table fitness values of a population
+	   @param probabilities probabilities (0..1) of the quantiles to calculate
+	   @return statistics of the population
+
+	   Calculates mean, variance, minimum, maximum, median & the requested
+	   quantiles of an evaluated population. Sums are compensated and reduced in
+	   fixed blocks, the result doesn't depend on the number of threads. The
+	   quantile of probability p is the value at rank floor(p * count) in sorted
+	   order (the last value for p = 1), the median is the quantile of 0.5.
+
+	   Throws std::invalid_argument if a probability is out of range and
+	   std::overflow_error if the total fitness exceeds the supported maximum.
+	 */
+	inline Summary summary(const FitnessTable &table, const std::vector<double> &probabilities = std::vector<double>())
+	{
+		for(const double p : probabilities)
+		{
+			if(!(p >= 0.0 && p <= 1.0))
+			{
+				throw std::invalid_argument("Probability out of range.");
+			}
+		}
+
+		Summary result;
+
+		result.count = table.size();
+		result.quantiles.assign(probabilities.size(), std::numeric_limits<double>::quiet_NaN());
+
+		if(result.count == 0)
+		{
+			return result;
+		}
+
+		struct Block
+		{
+			detail::CompensatedSum sum;
+			detail::CompensatedSum squares;
+			size_t argmin;
+			size_t argmax;
+		};
+
+		const double *values = table.data();
+		const size_t count = result.count;
+		const size_t blocks = (count + SUMMARY_BLOCK_SIZE - 1) / SUMMARY_BLOCK_SIZE;
+		std::vector<Block> partial(blocks);
+
+		#pragma omp parallel for
+		for(size_t b = 0; b < blocks; ++b)
+		{
+			const size_t first = b * SUMMARY_BLOCK_SIZE;
+			const size_t last = std::min(first + SUMMARY_BLOCK_SIZE, count);
+			Block &block = partial[b];
+
+			block.argmin = block.argmax = first;
 
-				if(Compare()(new_fitness, fitness))
+			for(size_t i = first; i < last; ++i)
+			{
+				block.sum.add(values[i]);
+
+				if(values[i] < values[block.argmin])
+				{
+					block.argmin = i;
+				}
+
+				if(values[i] > values[block.argmax])
 				{
-					fittest = opponent;
-					fitness = new_fitness;
+					block.argmax = i;
 				}
 			}
 		}
 
-		return std::make_tuple(fittest, fitness);
+		detail::CompensatedSum sum;
+
+		result.argmin = partial[0].argmin;
+		result.argmax = partial[0].argmax;
+
+		for(const Block &block : partial)
+		{
+			sum.add(block.sum.total());
+
+			if(values[block.argmin] < values[result.argmin])
+			{
+				result.argmin = block.argmin;
+			}
+
+			if(values[block.argmax] > values[result.argmax])
+			{
+				result.argmax = block.argmax;
+			}
+		}
+
+		result.min = values[result.argmin];
+		result.max = values[result.argmax];
+
+		// finite values can only add up to a non-finite value if the sum overflows:
+		if(!std::isfinite(sum.total()) && std::isfinite(result.min) && std::isfinite(result.max))
+		{
+			throw std::overflow_error("Arithmetic overflow.");
+		}
+
+		result.mean = sum.total() / count;
+
+		#pragma omp parallel for
+		for(size_t b = 0; b < blocks; ++b)
+		{
+			const size_t first = b * SUMMARY_BLOCK_SIZE;
+			const size_t last = std::min(first + SUMMARY_BLOCK_SIZE, count);
+
+			for(size_t i = first; i < last; ++i)
+			{
+				const double d = values[i] - result.mean;
+
+				partial[b].squares.add(d * d);
+			}
+		}
+
+		detail::CompensatedSum squares;
+
+		for(const Block &block : partial)
+		{
+			squares.add(block.squares.total());
+		}
+
+		result.variance = squares.total() / count;
+
+		// select ranks in ascending order, each nth_element call only searches the upper part:
+		auto rank = [count](const double p)
+		{
+			return std::min(static_cast<size_t>(p * count), count - 1);
+		};
+
+		std::vector<size_t> order(probabilities.size());
+
+		std::iota(std::begin(order), std::end(order), 0);
+		std::sort(std::begin(order), std::end(order), [&probabilities](size_t a, size_t b)
+		{
+			return probabilities[a] < probabilities[b];
+		});
+
+		std::vector<double> sorted(table.begin(), table.end());
+		const size_t middle = count / 2;
+		bool median_found = false;
+		size_t lower = 0;
+
+		auto select = [&](const size_t r)
+		{
+			std::nth_element(std::begin(sorted) + lower, std::begin(sorted) + r, std::end(sorted));
+			lower = r;
+
+			return sorted[r];
+		};
+
+		for(const size_t i : order)
+		{
+			const size_t r = rank(probabilities[i]);
+
+			if(!median_found && middle <= r)
+			{
+				result.median = select(middle);
+				median_found = true;
+			}
+
+			result.quantiles[i] = select(r);
+		}
+
+		if(!median_found)
+		{
+			result.median = select(middle);
+		}
+
+		return result;
+	}
+
+	/**
+	   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	                   or batch function: void fun(PopulationIterator first, PopulationIterator last, double *out)
+	   @param first iterator pointing to the first chromosome of a population
+	   @param last iterator pointing to the end (element after the last element) of a population
+	   @param fn a fitness function
+	   @param probabilities probabilities (0..1) of the quantiles to calculate
+	   @return statistics of the population
+
+	   Evaluates each chromosome once in parallel & calculates the statistics of
+	   the population (see summary(const FitnessTable &, const std::vector<double> &)).
+
+	   Throws std::invalid_argument if a probability is out of range and
+	   std::overflow_error if the total fitness exceeds the supported maximum.
+	 */
+	template<typename PopulationIterator, typename Fitness>
+	Summary summary(PopulationIterator first, PopulationIterator last, Fitness fn, const std::vector<double> &probabilities = std::vector<double>())
+	{
+		return summary(FitnessTable(first, last, fn), probabilities);
 	}
 }
 
 #endif
-
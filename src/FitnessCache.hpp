@@ -0,0 +1,308 @@
+/***************************************************************************
+    begin........: October 2026
+    copyright....: Sebastian Fedrau
+    email........: sebastian.fedrau@gmail.com
+ ***************************************************************************/
+
+/***************************************************************************
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License v3 as published by
+    the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License v3 for more details.
+ ***************************************************************************/
+/**
+   @file FitnessCache.hpp
+   @brief A thread-safe fitness cache keyed by chromosome content.
+   @author Sebastian Fedrau <sebastian.fedrau@gmail.com>
+ */
+#ifndef EA_FITNESS_CACHE_HPP
+#define EA_FITNESS_CACHE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "Random.hpp"
+
+namespace ea::fitness
+{
+	/**
+	   @class Cache
+	   @tparam Chromosome chromosome type, must be constructible from an iterator range
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	   @brief Wraps a fitness function & caches fitness values by chromosome content.
+
+	   The cache holds a bounded number of chromosomes. The limit counts entries, not
+	   bytes: each entry stores a copy of the chromosome, its hash & fitness, so the
+	   memory used grows with the chromosome size. Entries are distributed over
+	   shards, each protected by its own mutex. When a shard is full the CLOCK
+	   algorithm evicts an entry that hasn't been used recently. The wrapped fitness
+	   function is called without holding a lock.
+
+	   Copies of the functor share the cache, so it survives being passed by value
+	   to selection operators and streams.
+	 */
+	template<typename Chromosome, typename Fitness>
+	class Cache
+	{
+		public:
+			/**
+			   @param fn a fitness function
+			   @param capacity maximum number of cached chromosomes
+			   @param shards number of independently locked partitions
+
+			   Throws std::invalid_argument if capacity or shards is zero.
+			 */
+			explicit Cache(Fitness fn, const size_t capacity = 65536, const size_t shards = 64)
+				: fn(fn)
+			{
+				if(capacity == 0 || shards == 0)
+				{
+					throw std::invalid_argument("Capacity and number of shards cannot be zero.");
+				}
+
+				state = std::make_shared<State>(std::min(capacity, shards), capacity);
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyForwardIterator
+			   @param first points to the first element of a chromosome
+			   @param last points to the end of a chromosome
+			   @return fitness of the chromosome
+
+			   Returns the cached fitness of a chromosome or evaluates & stores it.
+			 */
+			template<typename InputIterator>
+			double operator()(InputIterator first, InputIterator last) const
+			{
+				const uint64_t hash = hash_genes(first, last);
+				Shard &shard = state->shards[(hash >> 32) % state->count];
+				double fitness;
+
+				if(shard.find(hash, first, last, fitness))
+				{
+					++state->hits;
+				}
+				else
+				{
+					++state->misses;
+					fitness = fn(first, last);
+					shard.store(hash, first, last, fitness);
+				}
+
+				return fitness;
+			}
+
+			/**
+			   @return number of fitness values found in the cache
+			 */
+			size_t hits() const
+			{
+				return state->hits;
+			}
+
+			/**
+			   @return number of evaluated chromosomes
+			 */
+			size_t misses() const
+			{
+				return state->misses;
+			}
+
+			/**
+			   @return number of cached chromosomes
+			 */
+			size_t size() const
+			{
+				size_t size = 0;
+
+				for(size_t i = 0; i < state->count; ++i)
+				{
+					size += state->shards[i].size();
+				}
+
+				return size;
+			}
+
+			/**
+			   Removes all cached chromosomes & resets the counters.
+			 */
+			void clear()
+			{
+				for(size_t i = 0; i < state->count; ++i)
+				{
+					state->shards[i].clear();
+				}
+
+				state->hits = 0;
+				state->misses = 0;
+			}
+
+		private:
+			class Shard
+			{
+				public:
+					void reserve(const size_t capacity)
+					{
+						this->capacity = capacity;
+						slots.reserve(capacity);
+					}
+
+					template<typename InputIterator>
+					bool find(const uint64_t hash, InputIterator first, InputIterator last, double &fitness)
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+
+						auto found = index.find(hash);
+
+						if(found != end(index))
+						{
+							Slot &slot = slots[found->second];
+
+							if(std::equal(first, last, begin(slot.genome), end(slot.genome)))
+							{
+								slot.referenced = true;
+								fitness = slot.fitness;
+
+								return true;
+							}
+						}
+
+						return false;
+					}
+
+					template<typename InputIterator>
+					void store(const uint64_t hash, InputIterator first, InputIterator last, const double fitness)
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+
+						auto found = index.find(hash);
+						size_t offset;
+
+						if(found != end(index)) // same or colliding chromosome, replace it
+						{
+							offset = found->second;
+						}
+						else if(slots.size() < capacity)
+						{
+							offset = slots.size();
+							slots.push_back(Slot());
+						}
+						else
+						{
+							// CLOCK: give referenced entries a second chance
+							while(slots[hand].referenced)
+							{
+								slots[hand].referenced = false;
+								hand = (hand + 1) % capacity;
+							}
+
+							offset = hand;
+							hand = (hand + 1) % capacity;
+							index.erase(slots[offset].hash);
+						}
+
+						slots[offset] = { hash, Chromosome(first, last), fitness, true };
+						index[hash] = offset;
+					}
+
+					size_t size()
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+
+						return slots.size();
+					}
+
+					void clear()
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+
+						slots.clear();
+						index.clear();
+						hand = 0;
+					}
+
+				private:
+					struct Slot
+					{
+						uint64_t hash;
+						Chromosome genome;
+						double fitness;
+						bool referenced;
+					};
+
+					std::mutex mutex;
+					std::vector<Slot> slots;
+					std::unordered_map<uint64_t, size_t> index;
+					size_t capacity = 0;
+					size_t hand = 0;
+			};
+
+			struct State
+			{
+				State(const size_t count, const size_t capacity)
+					: shards(std::make_unique<Shard[]>(count))
+					, count(count)
+				{
+					// the remainder of the capacity is spread over the first shards:
+					for(size_t i = 0; i < count; ++i)
+					{
+						shards[i].reserve(capacity / count + (i < capacity % count ? 1 : 0));
+					}
+				}
+
+				std::unique_ptr<Shard[]> shards;
+				const size_t count;
+				std::atomic<size_t> hits = 0;
+				std::atomic<size_t> misses = 0;
+			};
+
+			// mutable, so function objects with a non-const call operator can be wrapped:
+			mutable Fitness fn;
+			std::shared_ptr<State> state;
+
+			template<typename InputIterator>
+			static uint64_t hash_genes(InputIterator first, InputIterator last)
+			{
+				using Gene = typename std::iterator_traits<InputIterator>::value_type;
+
+				uint64_t hash = 0;
+
+				for(auto g = first; g != last; ++g)
+				{
+					hash = random::derive_seed(hash, std::hash<Gene>()(*g));
+				}
+
+				return hash;
+			}
+	};
+
+	/**
+	   @tparam Chromosome chromosome type, must be constructible from an iterator range
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	   @param fn a fitness function
+	   @param capacity maximum number of cached chromosomes
+	   @param shards number of independently locked partitions
+	   @return new function object
+
+	   Wraps a fitness function & caches fitness values by chromosome content.
+	 */
+	template<typename Chromosome, typename Fitness>
+	Cache<Chromosome, Fitness> make_cache(Fitness fn, const size_t capacity = 65536, const size_t shards = 64)
+	{
+		return Cache<Chromosome, Fitness>(fn, capacity, shards);
+	}
+}
+
+#endif
@@ -31,9 +31,12 @@
 #include <numeric>
 #include <limits>
 #include <algorithm>
-#include <cfenv>
+#include <cmath>
+#include <random>
 
 #include "Random.hpp"
+#include "Fitness.hpp"
+#include "Utils.hpp"
 
 namespace ea::selection
 {
@@ -49,6 +52,204 @@ namespace ea::selection
 		inverse
 	};
 
+	/**
+	   @class AliasTable
+	   @brief Draws indices of a population with probabilities proportional to their
+	          fitness values in constant time (Vose's alias method).
+
+	   Fitness values are shifted by twice the absolute value of the lowest fitness
+	   if it's negative. With inverse proportionality the i-th lowest fitness value
+	   gets the weight of the i-th highest one.
+
+	   Build a table once per generation & pass it to FitnessProportional to draw
+	   several times from the same population. Drawing is thread-safe.
+	 */
+	class AliasTable
+	{
+		public:
+			/**
+			   Creates an empty table.
+			 */
+			AliasTable() = default;
+
+			/**
+			   @param table fitness values of a population
+			   @param proportionality specifies if probability is directly or inversely
+			                          proportional to the fitness value
+
+			   Builds the alias table in O(N), with inverse proportionality in O(N log N).
+
+			   Throws std::overflow_error if an overflow occurs.
+			 */
+			explicit AliasTable(const fitness::FitnessTable &table, const Proportionality proportionality = Proportionality::direct)
+				: columns(table.size())
+			{
+				const size_t length = table.size();
+
+				if(length == 0)
+				{
+					return;
+				}
+
+				double lowest = std::numeric_limits<double>::infinity();
+
+				#pragma omp parallel for reduction(min:lowest)
+				for(size_t i = 0; i < length; ++i)
+				{
+					lowest = std::min(lowest, table[i]);
+				}
+
+				const double alignment = std::abs(std::min(0.0, lowest)) * 2;
+				std::vector<double> weights(length);
+
+				// sum fixed-size blocks in order, so the result doesn't depend on the number of threads:
+				const size_t blocks = (length + BLOCK_SIZE - 1) / BLOCK_SIZE;
+				std::vector<double> sums(blocks, 0.0);
+
+				#pragma omp parallel for
+				for(size_t b = 0; b < blocks; ++b)
+				{
+					for(size_t i = b * BLOCK_SIZE; i < std::min(length, (b + 1) * BLOCK_SIZE); ++i)
+					{
+						weights[i] = table[i] + alignment;
+						sums[b] += weights[i];
+					}
+				}
+
+				const double sum = std::accumulate(begin(sums), end(sums), 0.0);
+
+				if(!std::isfinite(sum))
+				{
+					throw std::overflow_error("Arithmetic overflow.");
+				}
+
+				if(sum == 0) // all fitness values are zero, always draw the first individual
+				{
+					std::fill(begin(columns), end(columns), Column { 0.0, 0 });
+
+					return;
+				}
+
+				if(proportionality == Proportionality::inverse)
+				{
+					mirror(weights);
+				}
+
+				build(weights, sum);
+			}
+
+			/**
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param eng random engine
+			   @return random index
+
+			   Throws std::length_error if the table is empty.
+			 */
+			template<typename Engine>
+			size_t operator()(Engine &eng) const
+			{
+				if(columns.empty())
+				{
+					throw std::length_error("Population is empty.");
+				}
+
+				std::uniform_real_distribution<double> dist(0.0, static_cast<double>(columns.size()));
+
+				const double x = dist(eng);
+				const size_t index = std::min(static_cast<size_t>(x), columns.size() - 1);
+				const Column &column = columns[index];
+
+				return x - index < column.probability ? index : column.alias;
+			}
+
+			/**
+			   @return number of individuals
+			 */
+			size_t size() const
+			{
+				return columns.size();
+			}
+
+		private:
+			static constexpr size_t BLOCK_SIZE = 65536;
+
+			struct Column
+			{
+				double probability;
+				size_t alias;
+			};
+
+			std::vector<Column> columns;
+
+			// the weight of the i-th lowest value becomes the weight of the i-th highest one:
+			static void mirror(std::vector<double> &weights)
+			{
+				std::vector<size_t> order(weights.size());
+
+				std::iota(begin(order), end(order), 0);
+
+				std::sort(begin(order), end(order), [&weights](const size_t a, const size_t b)
+				{
+					return weights[a] < weights[b];
+				});
+
+				std::vector<double> mirrored(weights.size());
+
+				for(size_t i = 0; i < order.size(); ++i)
+				{
+					mirrored[order[i]] = weights[order[order.size() - i - 1]];
+				}
+
+				weights = std::move(mirrored);
+			}
+
+			void build(std::vector<double> &weights, const double sum)
+			{
+				const size_t length = weights.size();
+				const double scale = static_cast<double>(length) / sum;
+				std::vector<size_t> small;
+				std::vector<size_t> large;
+
+				#pragma omp parallel for
+				for(size_t i = 0; i < length; ++i)
+				{
+					weights[i] *= scale;
+				}
+
+				for(size_t i = 0; i < length; ++i)
+				{
+					(weights[i] < 1.0 ? small : large).push_back(i);
+				}
+
+				while(!small.empty() && !large.empty())
+				{
+					const size_t s = small.back();
+					const size_t l = large.back();
+
+					small.pop_back();
+					columns[s] = { weights[s], l };
+					weights[l] -= 1.0 - weights[s];
+
+					if(weights[l] < 1.0)
+					{
+						large.pop_back();
+						small.push_back(l);
+					}
+				}
+
+				// remaining columns are full, up to rounding errors:
+				for(const size_t i : large)
+				{
+					columns[i] = { 1.0, i };
+				}
+
+				for(const size_t i : small)
+				{
+					columns[i] = { 1.0, i };
+				}
+			}
+	};
+
 	/**
 	   @class FitnessProportional
 	   @brief Selects N individuals from a population. The probability for being selected
@@ -57,6 +258,9 @@ namespace ea::selection
 	class FitnessProportional
 	{
 		public:
+			/*! Fitness values can be passed as fitness::FitnessTable (see fitness::accepts_fitness_table_v). */
+			static constexpr bool accepts_fitness_table = true;
+
 			/**
 			   @param proportionality specifies if probability is directly or inversely
 			                          proportional to the fitness value
@@ -70,6 +274,7 @@ namespace ea::selection
 			/**
 			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
 			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
 			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
 			   @param first first individual of a population
 			   @param last points to the past-the-end element in the sequence
@@ -85,121 +290,273 @@ namespace ea::selection
 			template<typename InputIterator, typename Fitness, typename OutputIterator>
 			void operator()(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
 			{
-				std::vector<Slice> wheel;
+				select_indices(first, last, N, fitness, utils::make_gather_iterator(first, result));
+			}
 
-				const size_t length = insert_slices(first, last, fitness, std::back_inserter(wheel));
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
 
-				if(N > 0 && length == 0)
-				{
-					throw std::length_error("Population is empty.");
-				}
+			   Selects \p N individuals from a population and copies them to \p result.
 
-				std::sort(begin(wheel), end(wheel));
+			   Throws std::length_error if population is empty or std::overflow_error if an
+			   overflow occurs.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, fitness, utils::make_gather_iterator(first, result), eng);
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
 
-				const double sum = align(begin(wheel), end(wheel));
+			   Selects \p N individuals from an evaluated population and copies them to \p result.
 
-				if(sum == 0) // all fitness values are zero
-				{
-					std::fill_n(result, N, *first);
-				}
-				else
-				{
-					accumulate(begin(wheel), end(wheel), sum);
+			   Throws std::length_error if population is empty or the table doesn't match the
+			   population size and std::overflow_error if an overflow occurs.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result) const
+			{
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result));
+			}
 
-					std::vector<double> numbers;
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
 
-					random::fill_n_real(std::back_inserter(numbers), N, 0.0, 1.0);
+			   Selects \p N individuals from an evaluated population and copies them to \p result.
+			   Builds an AliasTable, pass the table directly to select several times from the
+			   same generation.
 
-					std::for_each(begin(numbers), end(numbers), [&](const double n)
-					{
-						auto slice = std::upper_bound(begin(wheel), end(wheel), n, [](const double n, const Slice &slice)
-						{
-							return n < slice.size;
-						});
+			   Throws std::length_error if population is empty or the table doesn't match the
+			   population size and std::overflow_error if an overflow occurs.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result), eng);
+			}
 
-						if(proportionality == Proportionality::inverse)
-						{
-							auto offset = std::distance(slice, std::prev(end(wheel)));
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table alias table of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
 
-							slice = begin(wheel) + offset;
-						}
+			   Selects \p N individuals with a prebuilt alias table and copies them to \p result.
+			   The proportionality of the alias table is used.
 
-						*result = *(first + slice->index);
-						++result;
-					});
-				}
+			   Throws std::length_error if population is empty or the table doesn't match the
+			   population size.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const AliasTable &table, OutputIterator result) const
+			{
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result));
 			}
 
-		private:
-			typedef struct _Slice
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table alias table of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals with a prebuilt alias table and copies them to \p result.
+			   The proportionality of the alias table is used.
+
+			   Throws std::length_error if population is empty or the table doesn't match the
+			   population size.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const AliasTable &table, OutputIterator result, Engine &eng) const
 			{
-				size_t index;
-				double size;
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result), eng);
+			}
 
-				bool operator<(const struct _Slice& rhs) const
-				{
-					return size < rhs.size;
-				}
-			} Slice;
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
 
-			const Proportionality proportionality;
+			   Selects \p N individuals from a population and writes their indices to \p result.
 
+			   Throws std::length_error if population is empty or std::overflow_error if an
+			   overflow occurs.
+			 */
 			template<typename InputIterator, typename Fitness, typename OutputIterator>
-			static size_t insert_slices(InputIterator first, InputIterator last, Fitness fitness, OutputIterator result)
+			void select_indices(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
 			{
-				return std::accumulate(first, last, 0, [&fitness, &result](const size_t index, auto &chromosome)
-				{
-					if(index == std::numeric_limits<size_t>::max())
-					{
-						throw std::overflow_error("Arithmetic overflow.");
-					}
+				select_indices(first, last, N, fitness, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
 
-					*result++ = { index, fitness(begin(chromosome), end(chromosome)) };
+			   Selects \p N individuals from a population and writes their indices to \p result.
 
-					return index + 1;
-				});
+			   Throws std::length_error if population is empty or std::overflow_error if an
+			   overflow occurs.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator, typename Engine>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, fitness::FitnessTable(first, last, fitness), result, eng);
 			}
 
-			template<typename Iterator>
-			static double align(Iterator first, Iterator last)
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from an evaluated population and writes their indices to \p result.
+
+			   Throws std::length_error if population is empty or the table doesn't match the
+			   population size and std::overflow_error if an overflow occurs.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result) const
 			{
-				std::feclearexcept(FE_OVERFLOW);
+				select_indices(first, last, N, table, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
 
-				const double alignment = std::abs(std::min(0.0, first->size)) * 2;
+			   Selects \p N individuals from an evaluated population and writes their indices to \p result.
+			   Builds an AliasTable, pass the table directly to select several times from the
+			   same generation.
 
-				test_fe_overflow();
+			   Throws std::length_error if population is empty or the table doesn't match the
+			   population size and std::overflow_error if an overflow occurs.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result, Engine &eng) const
+			{
+				fitness::check_table_size(table, std::distance(first, last));
 
-				return std::accumulate(first, last, 0.0, [&alignment](double sum, Slice &slice)
+				if(N > 0 && table.size() == 0)
 				{
-					slice.size += alignment;
-					test_fe_overflow();
-
-					sum += slice.size;
-					test_fe_overflow();
+					throw std::length_error("Population is empty.");
+				}
 
-					return sum;
-				});
+				select_indices(first, last, N, AliasTable(table, proportionality), result, eng);
 			}
 
-			template<typename Iterator>
-			static void accumulate(Iterator first, Iterator last, const double sum)
-			{
-				std::accumulate(first, last, 0.0, [sum](const double total, Slice &slice)
-				{
-					slice.size /= sum;
-					slice.size += total;
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table alias table of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
 
-					return slice.size;
-				});
+			   Selects \p N individuals with a prebuilt alias table and writes their indices to \p result.
+			   The proportionality of the alias table is used.
+
+			   Throws std::length_error if population is empty or the table doesn't match the
+			   population size.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const AliasTable &table, OutputIterator result) const
+			{
+				select_indices(first, last, N, table, result, random::thread_engine());
 			}
 
-			static void test_fe_overflow()
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table alias table of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals with a prebuilt alias table and writes their indices to \p result.
+			   The proportionality of the alias table is used.
+
+			   Throws std::length_error if population is empty or the table doesn't match the
+			   population size.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const AliasTable &table, OutputIterator result, Engine &eng) const
 			{
-				if(std::fetestexcept(FE_OVERFLOW))
+				if(table.size() != static_cast<size_t>(std::distance(first, last)))
 				{
-					throw std::overflow_error("Arithmetic overflow.");
+					throw std::length_error("Alias table doesn't match population size.");
+				}
+
+				for(size_t i = 0; i < N; ++i)
+				{
+					*result = table(eng);
+					++result;
 				}
 			}
+
+		private:
+			const Proportionality proportionality;
 	};
 }
 
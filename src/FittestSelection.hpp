@@ -23,8 +23,14 @@
 #define EA_FITTEST_SELECTION_HPP
 
 #include <limits>
-#include <set>
 #include <stdexcept>
+#include <iterator>
+#include <vector>
+#include <algorithm>
+#include <optional>
+
+#include "Fitness.hpp"
+#include "Utils.hpp"
 
 namespace ea::selection
 {
@@ -37,9 +43,13 @@ namespace ea::selection
 	class Fittest
 	{
 		public:
+			/*! Fitness values can be passed as fitness::FitnessTable (see fitness::accepts_fitness_table_v). */
+			static constexpr bool accepts_fitness_table = true;
+
 			/**
 			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
 			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
 			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
 			   @param first first individual of a population
 			   @param last points to the past-the-end element in the sequence
@@ -49,49 +59,262 @@ namespace ea::selection
 
 			   Selects \p N individuals from a population and copies them to \p result.
 
-			   Throws std::length_error if N exceeds population size or std::overflow_error
-			   if the number of individuals exceeds size_t.
+			   If the fitness function provides a bounded function (see fitness::has_bounded_v)
+			   chromosomes are evaluated with the fitness of the N-th best chromosome found so
+			   far as cutoff.
+
+			   Throws std::length_error if N exceeds population size.
 			 */
 			template<typename InputIterator, typename Fitness, typename OutputIterator>
 			void operator()(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
 			{
-				std::multiset<Chromosome> chromosomes;
-				size_t i = 0;
+				select_indices(first, last, N, fitness, utils::make_gather_iterator(first, result));
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from an evaluated population and copies them to \p result.
+			   The selected individuals are ordered by fitness, individuals with equal fitness
+			   by their position in the population.
+
+			   Small N are collected in bounded heaps, one per thread. Larger N are selected
+			   with nth_element from chunks of the population in parallel.
+
+			   Throws std::length_error if N exceeds population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result) const
+			{
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result));
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
 
-				for(auto p = first; p != last; ++p, ++i)
+			   Selects \p N individuals from a population and writes their indices to \p result.
+
+			   If the fitness function provides a bounded function (see fitness::has_bounded_v)
+			   chromosomes are evaluated with the fitness of the N-th best chromosome found so
+			   far as cutoff.
+
+			   Throws std::length_error if N exceeds population size.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
+			{
+				if constexpr(fitness::has_bounded_v<Fitness, decltype(std::begin(*first))>)
+				{
+					select_bounded(first, last, N, fitness, result);
+				}
+				else
 				{
-					chromosomes.insert({ i, fitness(begin(*p), end(*p)) });
+					select_indices(first, last, N, fitness::FitnessTable(first, last, fitness), result);
+				}
+			}
 
-					if(i == std::numeric_limits<size_t>::max())
-					{
-						throw std::overflow_error("Arithmetic overflow.");
-					}
-				};
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from an evaluated population and writes their indices to \p result.
+			   The selected individuals are ordered by fitness, individuals with equal fitness
+			   by their position in the population.
 
-				if(chromosomes.size() < N)
+			   Small N are collected in bounded heaps, one per thread. Larger N are selected
+			   with nth_element from chunks of the population in parallel.
+
+			   Throws std::length_error if N exceeds population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result) const
+			{
+				fitness::check_table_size(table, std::distance(first, last));
+
+				if(table.size() < N)
 				{
 					throw std::length_error("N exceeds population size.");
 				}
 
-				i = 0;
+				if(N == 0)
+				{
+					return;
+				}
+
+				std::vector<Candidate> candidates;
 
-				for(auto c = begin(chromosomes); c != end(chromosomes) && i < N; ++c, ++i, ++result)
+				if(N <= HEAP_LIMIT)
 				{
-					*result = *(first + c->index);
-				};
+					#pragma omp parallel
+					{
+						std::vector<Candidate> heap;
+
+						#pragma omp for
+						for(size_t i = 0; i < table.size(); ++i)
+						{
+							push_bounded(heap, N, { i, table[i] });
+						}
+
+						#pragma omp critical
+						std::move(begin(heap), end(heap), std::back_inserter(candidates));
+					}
+				}
+				else
+				{
+					candidates.resize(table.size());
+
+					// keep the N best candidates of each chunk, chunks are compacted afterwards:
+					const size_t chunk_size = std::max(N * 4, MIN_CHUNK_SIZE);
+					const size_t chunks = (table.size() + chunk_size - 1) / chunk_size;
+
+					#pragma omp parallel for
+					for(size_t c = 0; c < chunks; ++c)
+					{
+						const size_t offset = c * chunk_size;
+						const size_t count = std::min(chunk_size, table.size() - offset);
+
+						for(size_t i = offset; i < offset + count; ++i)
+						{
+							candidates[i] = { i, table[i] };
+						}
+
+						if(count > N)
+						{
+							std::nth_element(begin(candidates) + offset, begin(candidates) + offset + N, begin(candidates) + offset + count);
+						}
+					}
+
+					size_t size = 0;
+
+					for(size_t c = 0; c < chunks; ++c)
+					{
+						const size_t offset = c * chunk_size;
+						const size_t count = std::min({ chunk_size, table.size() - offset, N });
+
+						std::move(begin(candidates) + offset, begin(candidates) + offset + count, begin(candidates) + size);
+						size += count;
+					}
+
+					candidates.resize(size);
+				}
+
+				copy_indices(candidates, N, result);
 			}
 
 		private:
-			struct Chromosome
+			// up to this N bounded heaps are used, larger N select from a flat array:
+			static constexpr size_t HEAP_LIMIT = 256;
+			static constexpr size_t MIN_CHUNK_SIZE = 65536;
+
+			struct Candidate
 			{
-				const size_t index;
-				const double fitness;
+				size_t index;
+				double fitness;
 
-				bool operator<(const struct Chromosome& rhs) const
+				// orders by fitness, ties by index:
+				bool operator<(const struct Candidate& rhs) const
 				{
-					return Compare()(fitness, rhs.fitness);
+					return Compare()(fitness, rhs.fitness) || (!Compare()(rhs.fitness, fitness) && index < rhs.index);
 				}
 			};
+
+			template<typename InputIterator, typename Fitness, typename OutputIterator>
+			void select_bounded(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
+			{
+				const auto length = std::distance(first, last);
+
+				if(length < 0 || static_cast<size_t>(length) < N)
+				{
+					throw std::length_error("N exceeds population size.");
+				}
+
+				if(N == 0)
+				{
+					return;
+				}
+
+				std::vector<Candidate> candidates;
+
+				#pragma omp parallel
+				{
+					// max-heap, the N-th best candidate of this thread is on top:
+					std::vector<Candidate> heap;
+
+					#pragma omp for
+					for(typename std::remove_const<decltype(length)>::type i = 0; i < length; ++i)
+					{
+						auto &chromosome = *(first + i);
+
+						if(heap.size() < N)
+						{
+							push_bounded(heap, N, { static_cast<size_t>(i), fitness(std::begin(chromosome), std::end(chromosome)) });
+						}
+						else
+						{
+							const std::optional<double> f = fitness.bounded(std::begin(chromosome), std::end(chromosome), heap.front().fitness);
+
+							if(f)
+							{
+								push_bounded(heap, N, { static_cast<size_t>(i), *f });
+							}
+						}
+					}
+
+					#pragma omp critical
+					std::move(begin(heap), end(heap), std::back_inserter(candidates));
+				}
+
+				copy_indices(candidates, N, result);
+			}
+
+			// max-heap of the N best candidates, the N-th best one is on top:
+			static void push_bounded(std::vector<Candidate> &heap, const size_t N, const Candidate &candidate)
+			{
+				if(heap.size() < N)
+				{
+					heap.push_back(candidate);
+					std::push_heap(begin(heap), end(heap));
+				}
+				else if(candidate < heap.front())
+				{
+					std::pop_heap(begin(heap), end(heap));
+					heap.back() = candidate;
+					std::push_heap(begin(heap), end(heap));
+				}
+			}
+
+			template<typename OutputIterator>
+			static void copy_indices(std::vector<Candidate> &candidates, const size_t N, OutputIterator result)
+			{
+				std::nth_element(begin(candidates), begin(candidates) + N - 1, end(candidates));
+				std::sort(begin(candidates), begin(candidates) + N);
+
+				std::transform(begin(candidates), begin(candidates) + N, result, [](auto &candidate)
+				{
+					return candidate.index;
+				});
+			}
 	};
 }
 
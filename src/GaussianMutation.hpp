@@ -26,6 +26,7 @@
 #include <vector>
 #include <limits>
 #include <stdexcept>
+#include <cfenv>
 
 #include "Random.hpp"
 
@@ -42,13 +43,18 @@ namespace ea::mutation
 			   @param min minimum potential value
 			   @param max maximum potential value
 			   @param probability probability a gene is changed
+			   @param sampling algorithm used to choose the changed genes
 
 			   Throws std::invalid_argument if probability is out of range (0.0 <= p <= 1.0).
 			 */
-			explicit Gaussian(const double min, const double max, const double probability = 0.8)
+			explicit Gaussian(const double min,
+			                  const double max,
+			                  const double probability = 0.8,
+			                  const random::BernoulliSampling sampling = random::BernoulliSampling::automatic)
 				: min(min)
 				, max(max)
 				, probability(probability)
+				, sampling(sampling)
 			{
 				if(probability <= 0.0 || probability >= 1.0)
 				{
@@ -66,30 +72,44 @@ namespace ea::mutation
 			template<typename InputIterator>
 			void operator()(InputIterator first, InputIterator last) const
 			{
-				random::RandomEngine engine = random::default_engine();
-				std::uniform_real_distribution<double> prob(0.0, 1.0);
-				std::normal_distribution<double> dist(min, max);
+				(*this)(first, last, random::thread_engine());
+			}
 
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyInputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first points to the first element of a chromosome
+			   @param last points to the end of a chromosome
+			   @param eng random engine
+
+			   Throws std::overflow_error if an overflow occurs.
+			 */
+			template<typename InputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, Engine &eng) const
+			{
 				std::feclearexcept(FE_OVERFLOW);
 
-				for(auto g = first; g != last; ++g)
+				auto g = first;
+				size_t position = 0;
+
+				random::bernoulli_trials(std::distance(first, last), probability, eng, [&](const size_t offset)
 				{
-					if(prob(engine) <= probability)
-					{
-						*g += dist(engine);
+					std::advance(g, offset - position);
+					position = offset;
+					*g += min + max * random::normal(eng);
 
-						if(std::fetestexcept(FE_OVERFLOW))
-						{
-							throw std::overflow_error("Arithmetic overflow.");
-						}
+					if(std::fetestexcept(FE_OVERFLOW))
+					{
+						throw std::overflow_error("Arithmetic overflow.");
 					}
-				}
+				}, sampling);
 			}
 
 		private:
 			const double min;
 			const double max;
 			const double probability;
+			const random::BernoulliSampling sampling;
 	};
 }
 
@@ -0,0 +1,174 @@
+/***************************************************************************
+    begin........: October 2026
+    copyright....: Sebastian Fedrau
+    email........: sebastian.fedrau@gmail.com
+ ***************************************************************************/
+
+/***************************************************************************
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License v3 as published by
+    the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License v3 for more details.
+ ***************************************************************************/
+/**
+   @file Init.hpp
+   @brief Functions to initialize populations.
+   @author Sebastian Fedrau <sebastian.fedrau@gmail.com>
+ */
+#ifndef EA_INIT_HPP
+#define EA_INIT_HPP
+
+#include <iterator>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+
+#include "Random.hpp"
+
+namespace ea::init
+{
+	namespace detail
+	{
+		// invokes fn(chromosome, eng) for each individual in parallel, each individual
+		// gets its own engine derived from a seed drawn from eng:
+		template<typename PopulationIterator, typename Engine, typename F>
+		void for_each_individual(PopulationIterator first, PopulationIterator last, Engine &eng, F fn)
+		{
+			const auto length = std::distance(first, last);
+			const uint64_t seed = random::bits64(eng);
+
+			#pragma omp parallel for
+			for(typename std::remove_const<decltype(length)>::type i = 0; i < length; ++i)
+			{
+				random::RandomEngine gen(random::derive_seed(seed, i));
+
+				fn(*(first + i), gen);
+			}
+		}
+	}
+
+	/**
+	   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+	   @param first first individual of a population
+	   @param last points to the past-the-end element in the sequence
+	   @param eng random engine
+
+	   Overwrites each chromosome of length n with a random permutation of 0..n-1
+	   (Fisher-Yates shuffle). Chromosomes are initialized in parallel, the result
+	   does not depend on the number of threads.
+	 */
+	template<typename PopulationIterator, typename Engine>
+	void permutations(PopulationIterator first, PopulationIterator last, Engine &eng)
+	{
+		detail::for_each_individual(first, last, eng, [](auto &chromosome, auto &gen)
+		{
+			using Gene = typename std::iterator_traits<decltype(begin(chromosome))>::value_type;
+
+			std::iota(begin(chromosome), end(chromosome), Gene());
+			std::shuffle(begin(chromosome), end(chromosome), gen);
+		});
+	}
+
+	/**
+	   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+	   @param first first individual of a population
+	   @param last points to the past-the-end element in the sequence
+
+	   Overwrites each chromosome of length n with a random permutation of 0..n-1.
+	 */
+	template<typename PopulationIterator>
+	void permutations(PopulationIterator first, PopulationIterator last)
+	{
+		permutations(first, last, random::thread_engine());
+	}
+
+	/**
+	   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+	   @param first first individual of a population
+	   @param last points to the past-the-end element in the sequence
+	   @param eng random engine
+
+	   Overwrites the genes of each chromosome with random bits. Each random word
+	   provides 64 genes.
+	 */
+	template<typename PopulationIterator, typename Engine>
+	void bitstrings(PopulationIterator first, PopulationIterator last, Engine &eng)
+	{
+		detail::for_each_individual(first, last, eng, [](auto &chromosome, auto &gen)
+		{
+			uint64_t word = 0;
+			int bits = 0;
+
+			for(auto g = begin(chromosome); g != end(chromosome); ++g)
+			{
+				if(bits == 0)
+				{
+					word = random::bits64(gen);
+					bits = 64;
+				}
+
+				*g = word & 1;
+				word >>= 1;
+				--bits;
+			}
+		});
+	}
+
+	/**
+	   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+	   @param first first individual of a population
+	   @param last points to the past-the-end element in the sequence
+
+	   Overwrites the genes of each chromosome with random bits.
+	 */
+	template<typename PopulationIterator>
+	void bitstrings(PopulationIterator first, PopulationIterator last)
+	{
+		bitstrings(first, last, random::thread_engine());
+	}
+
+	/**
+	   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam T the type of the generated genes
+	   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+	   @param first first individual of a population
+	   @param last points to the past-the-end element in the sequence
+	   @param min minimum potentially generated value
+	   @param max maximum potentially generated value
+	   @param eng random engine
+
+	   Overwrites the genes of each chromosome with random floating-point values.
+	 */
+	template<typename PopulationIterator, typename T, typename Engine>
+	void reals(PopulationIterator first, PopulationIterator last, const T min, const T max, Engine &eng)
+	{
+		detail::for_each_individual(first, last, eng, [min, max](auto &chromosome, auto &gen)
+		{
+			random::fill_n_real(begin(chromosome), std::distance(begin(chromosome), end(chromosome)), min, max, gen);
+		});
+	}
+
+	/**
+	   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam T the type of the generated genes
+	   @param first first individual of a population
+	   @param last points to the past-the-end element in the sequence
+	   @param min minimum potentially generated value
+	   @param max maximum potentially generated value
+
+	   Overwrites the genes of each chromosome with random floating-point values.
+	 */
+	template<typename PopulationIterator, typename T>
+	void reals(PopulationIterator first, PopulationIterator last, const T min, const T max)
+	{
+		reals(first, last, min, max, random::thread_engine());
+	}
+}
+
+#endif
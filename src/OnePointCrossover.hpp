@@ -63,6 +63,33 @@ namespace ea::crossover
 					  InputIterator first2,
 					  InputIterator last2,
 					  OutputIterator result) const
+			{
+				return (*this)(first1, last1, first2, last2, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first1 points to the first element of the first chromosome
+			   @param last1 points to the end of the first chromosome
+			   @param first2 points to the first element of the second chromosome
+			   @param last2 points to the end of the second chromosome
+			   @param result beginning of the destination range
+			   @param eng random engine
+			   @return number of offsprings written to \p result
+
+			   Combines two parents and generates two offsprings.
+
+			   Throws std::length_error if at least a single chromosome is empty.
+			*/
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			size_t operator()(InputIterator first1,
+					  InputIterator last1,
+					  InputIterator first2,
+					  InputIterator last2,
+					  OutputIterator result,
+					  Engine &eng) const
 			{
 				const auto length1 = std::distance(first1, last1);
 				const auto length2 = std::distance(first2, last2);
@@ -74,7 +101,6 @@ namespace ea::crossover
 				}
 
 				std::uniform_int_distribution<typename std::remove_const<decltype(min)>::type> dist(0, min - 1);
-				random::RandomEngine eng = random::default_engine();
 				auto const separator = dist(eng);
 
 				Chromosome offspring1(length2);
@@ -64,6 +64,34 @@ namespace ea::crossover
 			                  InputIterator first2,
 			                  InputIterator last2,
 			                  OutputIterator result) const
+			{
+				return (*this)(first1, last1, first2, last2, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first1 points to the first element of the first chromosome
+			   @param last1 points to the end of the first chromosome
+			   @param first2 points to the first element of the second chromosome
+			   @param last2 points to the end of the second chromosome
+			   @param result beginning of the destination range
+			   @param eng random engine
+			   @return number of offsprings written to \p result
+			   
+			   Combines two parents and generates two offsprings.
+
+			   Throws std::length_error or std::logic_error if the genes of the parent
+			   chromosomes aren't the same.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			size_t operator()(InputIterator first1,
+			                  InputIterator last1,
+			                  InputIterator first2,
+			                  InputIterator last2,
+			                  OutputIterator result,
+			                  Engine &eng) const
 			{
 				const difference_type<InputIterator> length = std::distance(first1, last1);
 
@@ -72,8 +100,8 @@ namespace ea::crossover
 					throw std::length_error("Chromosome lengths have to be equal.");
 				}
 
-				append(first1, last1, first2, last2, length, result);
-				append(first2, last2, first1, last1, length, result);
+				append(first1, last1, first2, last2, length, result, eng);
+				append(first2, last2, first1, last1, length, result, eng);
 
 				return 2;
 			}
@@ -82,17 +110,18 @@ namespace ea::crossover
 			template<typename InputIterator>
 			using difference_type = typename std::iterator_traits<InputIterator>::difference_type;
 
-			template<typename InputIterator, typename OutputIterator>
+			template<typename InputIterator, typename OutputIterator, typename Engine>
 			static void append(InputIterator first1,
 			                   InputIterator last1,
 			                   InputIterator first2,
 			                   InputIterator last2,
 			                   const difference_type<InputIterator> length,
-			                   OutputIterator result)
+			                   OutputIterator result,
+			                   Engine &eng)
 			{
 				difference_type<InputIterator> from, to;
 
-				std::tie(from, to) = get_range(length);
+				std::tie(from, to) = get_range(length, eng);
 
 				Chromosome offspring(length);
 
@@ -123,12 +152,12 @@ namespace ea::crossover
 				*result++ = offspring;
 			}
 
-			template <typename Difference>
-			static std::tuple<Difference, Difference> get_range(const Difference length)
+			template <typename Difference, typename Engine>
+			static std::tuple<Difference, Difference> get_range(const Difference length, Engine &eng)
 			{
 				Difference range[2];
 
-				random::fill_distinct_n_int(range, 2, static_cast<Difference>(0), length - 1);
+				random::fill_distinct_n_int(range, 2, static_cast<Difference>(0), length - 1, eng);
 
 				return std::make_tuple(std::min(range[0], range[1]), std::max(range[0], range[1]));
 			}
@@ -63,6 +63,34 @@ namespace ea::crossover
 					  InputIterator first2,
 					  InputIterator last2,
 					  OutputIterator result) const
+			{
+				return (*this)(first1, last1, first2, last2, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first1 points to the first element of the first chromosome
+			   @param last1 points to the end of the first chromosome
+			   @param first2 points to the first element of the second chromosome
+			   @param last2 points to the end of the second chromosome
+			   @param result beginning of the destination range
+			   @param eng random engine
+			   @return number of offsprings written to \p result
+
+			   Combines two parents and generates two offsprings.
+
+			   Throws std::length_error or std::logic_error if the genes of the parent
+			   chromosomes aren't the same.
+			*/
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			size_t operator()(InputIterator first1,
+					  InputIterator last1,
+					  InputIterator first2,
+					  InputIterator last2,
+					  OutputIterator result,
+					  Engine &eng) const
 			{
 				const auto length = std::distance(first1, last1);
 
@@ -71,8 +99,8 @@ namespace ea::crossover
 					throw std::length_error("Chromosome lengths have to be equal.");
 				}
 
-				append<InputIterator>(first1, { first2, last2 }, length, result);
-				append<InputIterator>(first2, { first1, last1 }, length, result);
+				append<InputIterator>(first1, { first2, last2 }, length, result, eng);
+				append<InputIterator>(first2, { first1, last1 }, length, result, eng);
 
 				return 2;
 			}
@@ -81,14 +109,15 @@ namespace ea::crossover
 			template<typename T>
 			using Range = typename std::tuple<T, T>;
 
-			template<typename InputIterator, typename Difference, typename OutputIterator>
+			template<typename InputIterator, typename Difference, typename OutputIterator, typename Engine>
 			static void append(InputIterator first1,
 			                   Range<InputIterator> parent2,
 			                   const Difference length,
-			                   OutputIterator result)
+			                   OutputIterator result,
+			                   Engine &eng)
 			{
 				const auto &[first2, last2] = parent2;
-				const auto[from, to] = generate_swath(length);
+				const auto[from, to] = generate_swath(length, eng);
 
 				Chromosome offspring(length);
 
@@ -119,12 +148,12 @@ namespace ea::crossover
 				*result++ = offspring;
 			}
 
-			template <typename T>
-			static Range<T> generate_swath(const T length)
+			template <typename T, typename Engine>
+			static Range<T> generate_swath(const T length, Engine &eng)
 			{
 				T swath[2];
 
-				random::fill_distinct_n_int(swath, 2, static_cast<T>(0), length - 1);
+				random::fill_distinct_n_int(swath, 2, static_cast<T>(0), length - 1, eng);
 
 				return std::make_tuple(std::min(swath[0], swath[1]), std::max(swath[0], swath[1]));
 			}
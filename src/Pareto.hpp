@@ -0,0 +1,365 @@
+/***************************************************************************
+    begin........: October 2026
+    copyright....: Sebastian Fedrau
+    email........: sebastian.fedrau@gmail.com
+ ***************************************************************************/
+
+/***************************************************************************
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License v3 as published by
+    the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License v3 for more details.
+ ***************************************************************************/
+/**
+   @file Pareto.hpp
+   @brief Multi-objective fitness: non-dominated sorting & crowding distance.
+   @author Sebastian Fedrau <sebastian.fedrau@gmail.com>
+ */
+#ifndef EA_PARETO_HPP
+#define EA_PARETO_HPP
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace ea::pareto
+{
+	/**
+	   Fitness values of a chromosome, one per objective.
+	 */
+	using Objectives = std::vector<double>;
+
+	template<typename Fitness, typename ChromosomeIterator, typename = void>
+	struct is_objective_function : std::false_type {};
+
+	template<typename Fitness, typename ChromosomeIterator>
+	struct is_objective_function<Fitness,
+	                             ChromosomeIterator,
+	                             std::void_t<decltype(std::begin(std::declval<std::invoke_result_t<Fitness &, ChromosomeIterator, ChromosomeIterator> &>()))>>
+		: std::true_type {};
+
+	/**
+	   @tparam Fitness fitness function object
+	   @tparam ChromosomeIterator iterator type pointing to a gene
+
+	   True if \p Fitness is a multi-objective fitness function returning a range of
+	   objective values: Objectives fun(ChromosomeIterator first, ChromosomeIterator last)
+	 */
+	template<typename Fitness, typename ChromosomeIterator>
+	constexpr bool is_objective_function_v = is_objective_function<Fitness, ChromosomeIterator>::value;
+
+	/**
+	   @class ObjectiveTable
+	   @brief Objective values of a population, stored row by row in the order of the chromosomes.
+	 */
+	class ObjectiveTable
+	{
+		public:
+			/**
+			   Creates an empty table.
+			 */
+			ObjectiveTable() = default;
+
+			/**
+			   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: Objectives fun(InputIterator first, InputIterator last)
+			   @param first iterator pointing to the first chromosome of a population
+			   @param last iterator pointing to the end (element after the last element) of a population
+			   @param fn a multi-objective fitness function
+
+			   Evaluates all chromosomes of the range \p first to \p last in parallel.
+
+			   Throws std::length_error if the number of objectives differs between chromosomes
+			   or is zero.
+			 */
+			template<typename PopulationIterator, typename Fitness>
+			ObjectiveTable(PopulationIterator first, PopulationIterator last, Fitness fn)
+			{
+				using size_type = typename std::make_unsigned<typename std::iterator_traits<PopulationIterator>::difference_type>::type;
+
+				const size_type length = std::distance(first, last);
+				std::vector<Objectives> rows(length);
+
+				#pragma omp parallel for
+				for(size_type i = 0; i < length; ++i)
+				{
+					auto &chromosome = *(first + i);
+					const auto objectives = fn(std::begin(chromosome), std::end(chromosome));
+
+					rows[i].assign(std::begin(objectives), std::end(objectives));
+				}
+
+				if(length > 0)
+				{
+					m = rows[0].size();
+					values.reserve(length * m);
+
+					for(const auto &row : rows)
+					{
+						if(row.size() != m || m == 0)
+						{
+							throw std::length_error("Number of objectives has to be equal & greater than zero.");
+						}
+
+						values.insert(std::end(values), std::begin(row), std::end(row));
+					}
+				}
+			}
+
+			/**
+			   @param values objective values, stored row by row
+			   @param objectives number of objectives
+
+			   Creates a table from already known objective values.
+
+			   Throws std::invalid_argument if \p objectives is zero & std::length_error if the
+			   number of values isn't a multiple of \p objectives.
+			 */
+			ObjectiveTable(std::vector<double> values, const size_t objectives)
+				: values(std::move(values))
+				, m(objectives)
+			{
+				if(objectives == 0)
+				{
+					throw std::invalid_argument("Number of objectives cannot be zero.");
+				}
+
+				if(this->values.size() % objectives)
+				{
+					throw std::length_error("Number of values has to be a multiple of the number of objectives.");
+				}
+			}
+
+			/**
+			   @param index index of a chromosome
+			   @return pointer to the first objective value of the chromosome at the specified position
+			 */
+			const double *operator[](const size_t index) const
+			{
+				return values.data() + index * m;
+			}
+
+			/**
+			   @return number of stored chromosomes
+			 */
+			size_t size() const
+			{
+				return m > 0 ? values.size() / m : 0;
+			}
+
+			/**
+			   @return number of objectives
+			 */
+			size_t objectives() const
+			{
+				return m;
+			}
+
+		private:
+			std::vector<double> values;
+			size_t m = 0;
+	};
+
+	/**
+	   @tparam Compare function to compare objective values
+	   @param a objective values of the first chromosome
+	   @param b objective values of the second chromosome
+	   @param m number of objectives
+	   @return true if \p a is at least as good as \p b in all objectives and better in one
+	 */
+	template<typename Compare = std::greater<double>>
+	bool dominates(const double *a, const double *b, const size_t m)
+	{
+		bool better = false;
+
+		for(size_t i = 0; i < m; ++i)
+		{
+			if(Compare()(b[i], a[i]))
+			{
+				return false;
+			}
+
+			better = better || Compare()(a[i], b[i]);
+		}
+
+		return better;
+	}
+
+	/**
+	   @tparam Compare function to compare objective values
+	   @param table objective values of a population
+	   @return front of each chromosome, 0 for the non-dominated chromosomes
+
+	   Assigns each chromosome to a Pareto front. Chromosomes are sorted
+	   lexicographically first, so no chromosome can dominate a preceding one.
+	   Each chromosome is then inserted into the first front none of whose
+	   members dominates it, found by binary search (efficient non-dominated
+	   sort). With two objectives only the last member of a front has to be
+	   checked, which results in O(N log N). With three or more objectives the
+	   members of a front are compared, O(M N^2) in the worst case (e.g. all
+	   chromosomes in one front) but usually much less, and in contrast to
+	   fast-non-dominated-sort without storing the domination relation.
+	   O(N log N) for three objectives would require a sweep over a balanced
+	   tree, which isn't implemented.
+	 */
+	template<typename Compare = std::greater<double>>
+	std::vector<size_t> non_dominated_sort(const ObjectiveTable &table)
+	{
+		const size_t length = table.size();
+		const size_t m = table.objectives();
+		std::vector<size_t> order(length);
+		std::vector<size_t> ranks(length);
+		std::vector<std::vector<size_t>> fronts;
+
+		std::iota(begin(order), end(order), 0);
+
+		std::sort(begin(order), end(order), [&table, m](const size_t a, const size_t b)
+		{
+			const double *x = table[a];
+			const double *y = table[b];
+
+			for(size_t i = 0; i < m; ++i)
+			{
+				if(Compare()(x[i], y[i]))
+				{
+					return true;
+				}
+
+				if(Compare()(y[i], x[i]))
+				{
+					return false;
+				}
+			}
+
+			return a < b;
+		});
+
+		auto dominated = [&](const size_t front, const size_t index)
+		{
+			const auto &members = fronts[front];
+
+			if(m == 2)
+			{
+				// the last member of a two-dimensional front has the best second objective:
+				return dominates<Compare>(table[members.back()], table[index], m);
+			}
+
+			return std::any_of(members.rbegin(), members.rend(), [&](const size_t member)
+			{
+				return dominates<Compare>(table[member], table[index], m);
+			});
+		};
+
+		for(const size_t index : order)
+		{
+			size_t low = 0;
+			size_t high = fronts.size();
+
+			while(low < high)
+			{
+				const size_t mid = low + (high - low) / 2;
+
+				if(dominated(mid, index))
+				{
+					low = mid + 1;
+				}
+				else
+				{
+					high = mid;
+				}
+			}
+
+			if(low == fronts.size())
+			{
+				fronts.emplace_back();
+			}
+
+			fronts[low].push_back(index);
+			ranks[index] = low;
+		}
+
+		return ranks;
+	}
+
+	/**
+	   @param table objective values of a population
+	   @param ranks front of each chromosome (see non_dominated_sort())
+	   @return crowding distance of each chromosome
+
+	   Sums up the normalized distance between the neighbors of each chromosome
+	   within its front for each objective. The boundary chromosomes of a front
+	   get an infinite distance.
+
+	   Throws std::length_error if \p ranks doesn't match the table size.
+	 */
+	inline std::vector<double> crowding_distance(const ObjectiveTable &table, const std::vector<size_t> &ranks)
+	{
+		if(ranks.size() != table.size())
+		{
+			throw std::length_error("Ranks don't match table size.");
+		}
+
+		std::vector<double> distances(ranks.size(), 0.0);
+		std::vector<std::vector<size_t>> fronts;
+
+		for(size_t i = 0; i < ranks.size(); ++i)
+		{
+			if(ranks[i] >= fronts.size())
+			{
+				fronts.resize(ranks[i] + 1);
+			}
+
+			fronts[ranks[i]].push_back(i);
+		}
+
+		#pragma omp parallel for schedule(dynamic)
+		for(size_t f = 0; f < fronts.size(); ++f)
+		{
+			auto &front = fronts[f];
+
+			for(size_t objective = 0; objective < table.objectives(); ++objective)
+			{
+				auto value = [&table, objective](const size_t index)
+				{
+					return table[index][objective];
+				};
+
+				std::sort(begin(front), end(front), [&value](const size_t a, const size_t b)
+				{
+					return value(a) < value(b) || (value(a) == value(b) && a < b);
+				});
+
+				if(front.empty())
+				{
+					continue;
+				}
+
+				distances[front.front()] = std::numeric_limits<double>::infinity();
+				distances[front.back()] = std::numeric_limits<double>::infinity();
+
+				const double range = value(front.back()) - value(front.front());
+
+				if(range > 0.0)
+				{
+					for(size_t i = 1; i + 1 < front.size(); ++i)
+					{
+						distances[front[i]] += (value(front[i + 1]) - value(front[i - 1])) / range;
+					}
+				}
+			}
+		}
+
+		return distances;
+	}
+}
+
+#endif
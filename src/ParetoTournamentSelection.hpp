@@ -0,0 +1,279 @@
+/***************************************************************************
+    begin........: October 2026
+    copyright....: Sebastian Fedrau
+    email........: sebastian.fedrau@gmail.com
+ ***************************************************************************/
+
+/***************************************************************************
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License v3 as published by
+    the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License v3 for more details.
+ ***************************************************************************/
+/**
+   @file ParetoTournamentSelection.hpp
+   @brief Tournament selection by Pareto front & crowding distance.
+   @author Sebastian Fedrau <sebastian.fedrau@gmail.com>
+ */
+#ifndef EA_PARETO_TOURNAMENT_SELECTION_HPP
+#define EA_PARETO_TOURNAMENT_SELECTION_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Random.hpp"
+#include "Utils.hpp"
+#include "Pareto.hpp"
+
+namespace ea::selection
+{
+	/**
+	   @class ParetoTournament
+	   @tparam Compare function to compare objective values
+	   @brief Selects N random individuals from a population & compares each one to Q
+	          random opponents (crowded-comparison of NSGA-II). An individual in a lower
+	          front wins, individuals in the same front are compared by crowding distance.
+	 */
+	template<typename Compare = std::greater<double>>
+	class ParetoTournament
+	{
+		public:
+			/**
+			   @param Q number of random opponents each selected individual is compared to
+
+			   Throws std::invalid_argument if Q is zero.
+			 */
+			explicit ParetoTournament(const size_t Q = 1)
+				: Q(Q)
+			{
+				if(Q == 0)
+				{
+					throw std::invalid_argument("Q cannot be zero.");
+				}
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: Objectives fun(InputIterator first, InputIterator last)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param N number of individuals to select from the population
+			   @param fitness a multi-objective fitness function
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from a population and copies them to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator>
+			std::enable_if_t<pareto::is_objective_function_v<Fitness, decltype(std::begin(*std::declval<InputIterator>()))>>
+			operator()(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
+			{
+				select_indices(first, last, N, fitness, utils::make_gather_iterator(first, result));
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: Objectives fun(InputIterator first, InputIterator last)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param N number of individuals to select from the population
+			   @param fitness a multi-objective fitness function
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from a population and copies them to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator, typename Engine>
+			std::enable_if_t<pareto::is_objective_function_v<Fitness, decltype(std::begin(*std::declval<InputIterator>()))>>
+			operator()(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, fitness, utils::make_gather_iterator(first, result), eng);
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param N number of individuals to select from the population
+			   @param table objective values of the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from an evaluated population and copies them to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const pareto::ObjectiveTable &table, OutputIterator result) const
+			{
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result));
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param N number of individuals to select from the population
+			   @param table objective values of the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from an evaluated population and copies them to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const pareto::ObjectiveTable &table, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result), eng);
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: Objectives fun(InputIterator first, InputIterator last)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param N number of individuals to select from the population
+			   @param fitness a multi-objective fitness function
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from a population and writes their indices to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator>
+			std::enable_if_t<pareto::is_objective_function_v<Fitness, decltype(std::begin(*std::declval<InputIterator>()))>>
+			select_indices(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
+			{
+				select_indices(first, last, N, fitness, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: Objectives fun(InputIterator first, InputIterator last)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param N number of individuals to select from the population
+			   @param fitness a multi-objective fitness function
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from a population and writes their indices to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator, typename Engine>
+			std::enable_if_t<pareto::is_objective_function_v<Fitness, decltype(std::begin(*std::declval<InputIterator>()))>>
+			select_indices(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, pareto::ObjectiveTable(first, last, fitness), result, eng);
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param N number of individuals to select from the population
+			   @param table objective values of the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from an evaluated population and writes their indices to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const pareto::ObjectiveTable &table, OutputIterator result) const
+			{
+				select_indices(first, last, N, table, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param N number of individuals to select from the population
+			   @param table objective values of the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from an evaluated population and writes their indices to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const pareto::ObjectiveTable &table, OutputIterator result, Engine &eng) const
+			{
+				const difference_type<InputIterator> length = std::distance(first, last);
+
+				if(table.size() != static_cast<size_t>(length))
+				{
+					throw std::length_error("Objective table doesn't match population size.");
+				}
+
+				if(length < 0 || static_cast<typename std::make_unsigned<difference_type<InputIterator>>::type>(length) <= Q)
+				{
+					throw std::length_error("Q exceeds population size.");
+				}
+
+				const std::vector<size_t> ranks = pareto::non_dominated_sort<Compare>(table);
+				const std::vector<double> distances = pareto::crowding_distance(table, ranks);
+				std::uniform_int_distribution<difference_type<InputIterator>> index_dist(0, length - 1);
+				std::vector<difference_type<InputIterator>> opponents(Q);
+
+				utils::repeat(N, [&]()
+				{
+					random::fill_distinct_n_int(begin(opponents), Q, static_cast<difference_type<InputIterator>>(0), length - 1, eng);
+					difference_type<InputIterator> index = index_dist(eng);
+
+					while(std::find(begin(opponents), end(opponents), index) != end(opponents))
+					{
+						index = index_dist(eng);
+					}
+
+					for(const auto opponent : opponents)
+					{
+						if(ranks[opponent] < ranks[index]
+						   || (ranks[opponent] == ranks[index] && distances[opponent] > distances[index]))
+						{
+							index = opponent;
+						}
+					}
+
+					*result++ = static_cast<size_t>(index);
+				});
+			}
+
+		private:
+			template<typename InputIterator>
+			using difference_type = typename std::iterator_traits<InputIterator>::difference_type;
+
+			const size_t Q;
+	};
+}
+
+#endif
@@ -0,0 +1,636 @@
+/***************************************************************************
+    begin........: October 2026
+    copyright....: Sebastian Fedrau
+    email........: sebastian.fedrau@gmail.com
+ ***************************************************************************/
+
+/***************************************************************************
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License v3 as published by
+    the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License v3 for more details.
+ ***************************************************************************/
+/**
+   @file ProcessFitness.hpp
+   @brief Evaluation of fitness functions in worker processes.
+   @author Sebastian Fedrau <sebastian.fedrau@gmail.com>
+ */
+#ifndef EA_PROCESS_FITNESS_HPP
+#define EA_PROCESS_FITNESS_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ea::fitness
+{
+	/**
+	   @class ProcessPool
+	   @tparam Chromosome chromosome type, must be constructible from an iterator range
+	                      of trivially copyable genes
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	   @tparam Compare function to compare fitness values
+	   @brief Evaluates chromosomes in forked worker processes.
+
+	   Use the pool for fitness functions which aren't thread-safe, e.g. wrappers
+	   around legacy code. ProcessPool is a batch fitness function: the genes of a
+	   batch are copied to a shared memory segment, each worker receives the offsets
+	   of some chromosomes over a Unix domain socket & returns the fitness values
+	   over the same socket.
+
+	   FitnessTable passes the whole population to the pool in a single call (see
+	   batch_size), outside of OpenMP parallel regions. The chromosomes are spread
+	   over all workers, each worker receives a new message as soon as it's idle.
+
+	   A worker that crashes or doesn't answer within the timeout is killed and
+	   replaced. The chromosomes it was evaluating get the fallback fitness value,
+	   by default the worst value according to \p Compare. If a replacement can't
+	   be forked, the pool continues with the remaining workers & tries again on
+	   the next call. Without any worker the chromosomes get the fallback value.
+	   Other operating system errors are thrown as std::system_error.
+
+	   Workers are forked when the pool is created. Replacements are forked from
+	   the calling process, so the fitness function shouldn't depend on locks held
+	   by other threads at that time.
+
+	   Copies of the functor share the worker processes.
+	 */
+	template<typename Chromosome, typename Fitness, typename Compare = std::greater<double>>
+	class ProcessPool
+	{
+		using Gene = typename Chromosome::value_type;
+
+		static_assert(std::is_trivially_copyable_v<Gene>, "Genes must be trivially copyable.");
+		static_assert(alignof(Gene) <= alignof(uint64_t), "Unsupported gene alignment.");
+
+		public:
+			/*! The whole population is passed to the pool at once (see batch_size_v). */
+			static constexpr size_t batch_size = std::numeric_limits<size_t>::max();
+
+			/**
+			   @param fn a fitness function
+			   @param workers number of worker processes
+			   @param timeout maximum time a worker may spend on a message
+			   @param fallback fitness of chromosomes a worker failed to evaluate
+			   @param capacity size of the shared memory segment in bytes
+
+			   Throws std::invalid_argument if \p workers or \p capacity is zero and
+			   std::system_error if the operating system fails to create a worker.
+			 */
+			explicit ProcessPool(Fitness fn,
+			                     const size_t workers = std::max<size_t>(std::thread::hardware_concurrency(), 1),
+			                     const std::chrono::milliseconds timeout = std::chrono::seconds(60),
+			                     const double fallback = worst(),
+			                     const size_t capacity = 64 * 1024 * 1024)
+			{
+				if(workers == 0 || capacity == 0)
+				{
+					throw std::invalid_argument("Number of workers and capacity cannot be zero.");
+				}
+
+				state = std::make_shared<State>(fn, workers, timeout, fallback, capacity);
+			}
+
+			/**
+			   @tparam PopulationIterator must meet the requirements of LegacyForwardIterator
+			   @param first iterator pointing to the first chromosome of a population
+			   @param last iterator pointing to the end (element after the last element) of a population
+			   @param out destination of the fitness values
+
+			   Evaluates the chromosomes of the range \p first to \p last in the worker
+			   processes. Concurrent calls are serialized.
+
+			   Throws std::length_error if a chromosome doesn't fit into the shared memory
+			   segment and std::system_error if waiting for the workers fails.
+			 */
+			template<typename PopulationIterator>
+			void operator()(PopulationIterator first, PopulationIterator last, double *out) const
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+
+				while(first != last)
+				{
+					std::vector<uint64_t> offsets;
+
+					first = state->pack(first, last, offsets);
+					state->dispatch(offsets, out);
+					out += offsets.size();
+				}
+			}
+
+			/**
+			   @return number of messages workers failed to answer
+			 */
+			size_t failures() const
+			{
+				return state->failures;
+			}
+
+			/**
+			   @return worst fitness value according to Compare, the default fallback value
+			 */
+			static double worst()
+			{
+				const double inf = std::numeric_limits<double>::infinity();
+
+				return Compare()(inf, -inf) ? -inf : inf;
+			}
+
+		private:
+			// a message holds the number of chromosomes followed by their offsets in the segment,
+			// each chromosome is stored as its length followed by its genes
+			struct Worker
+			{
+				pid_t pid = -1;
+				int fd = -1;
+				size_t first = 0; // range of offsets the worker is evaluating
+				size_t last = 0;
+				std::vector<double> received;
+				size_t bytes = 0;
+				std::chrono::steady_clock::time_point deadline;
+			};
+
+			class State
+			{
+				public:
+					State(Fitness fn, const size_t workers, const std::chrono::milliseconds timeout, const double fallback, const size_t capacity)
+						: fn(fn)
+						, workers(workers)
+						, timeout(timeout)
+						, fallback(fallback)
+						, capacity(capacity)
+					{
+						segment = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+						if(segment == MAP_FAILED)
+						{
+							throw std::system_error(errno, std::generic_category(), "mmap");
+						}
+
+						try
+						{
+							for(auto &w : this->workers)
+							{
+								spawn(w);
+							}
+						}
+						catch(...)
+						{
+							shutdown();
+							throw;
+						}
+					}
+
+					~State()
+					{
+						shutdown();
+					}
+
+					template<typename PopulationIterator>
+					PopulationIterator pack(PopulationIterator first, PopulationIterator last, std::vector<uint64_t> &offsets)
+					{
+						auto bytes = static_cast<uint8_t *>(segment);
+						size_t offset = 0;
+
+						for(; first != last; ++first)
+						{
+							const uint64_t length = std::distance(std::begin(*first), std::end(*first));
+							const size_t size = align(sizeof(uint64_t) + length * sizeof(Gene));
+
+							if(offset + size > capacity)
+							{
+								if(offsets.empty())
+								{
+									throw std::length_error("Chromosome exceeds shared memory segment.");
+								}
+
+								break;
+							}
+
+							std::memcpy(bytes + offset, &length, sizeof(uint64_t));
+							std::copy(std::begin(*first), std::end(*first), reinterpret_cast<Gene *>(bytes + offset + sizeof(uint64_t)));
+							offsets.push_back(offset);
+							offset += size;
+						}
+
+						return first;
+					}
+
+					void dispatch(const std::vector<uint64_t> &offsets, double *out)
+					{
+						revive();
+
+						const size_t chunk = std::max<size_t>(offsets.size() / (workers.size() * 4), 1);
+						size_t next = 0;
+						size_t done = 0;
+
+						while(done < offsets.size())
+						{
+							bool available = false;
+
+							for(auto &w : workers)
+							{
+								if(w.pid > 0 && w.last == w.first && next < offsets.size())
+								{
+									w.first = next;
+									w.last = std::min(next + chunk, offsets.size());
+									next = w.last;
+
+									if(!send(w, offsets))
+									{
+										done += fail(w, out);
+									}
+								}
+
+								available = available || w.pid > 0;
+							}
+
+							if(!available)
+							{
+								// no worker could be forked:
+								std::fill(out + next, out + offsets.size(), fallback);
+								done += offsets.size() - next;
+								next = offsets.size();
+							}
+
+							done += receive(out);
+						}
+					}
+
+					std::mutex mutex;
+					std::atomic<size_t> failures = 0;
+
+				private:
+					Fitness fn;
+					std::vector<Worker> workers;
+					const std::chrono::milliseconds timeout;
+					const double fallback;
+					const size_t capacity;
+					void *segment = MAP_FAILED;
+
+					static size_t align(const size_t size)
+					{
+						return (size + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+					}
+
+					void spawn(Worker &w)
+					{
+						int fds[2];
+
+						if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1)
+						{
+							throw std::system_error(errno, std::generic_category(), "socketpair");
+						}
+
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+						// macOS has no MSG_NOSIGNAL, suppress SIGPIPE on the sockets instead:
+						const int on = 1;
+
+						setsockopt(fds[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+						setsockopt(fds[1], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+						const pid_t pid = fork();
+
+						if(pid == -1)
+						{
+							const int err = errno;
+
+							close(fds[0]);
+							close(fds[1]);
+
+							throw std::system_error(err, std::generic_category(), "fork");
+						}
+
+						if(pid == 0)
+						{
+							close(fds[0]);
+
+							for(auto &other : workers)
+							{
+								if(other.fd != -1)
+								{
+									close(other.fd);
+								}
+							}
+
+							serve(fds[1]);
+						}
+
+						close(fds[1]);
+
+						w = Worker();
+						w.pid = pid;
+						w.fd = fds[0];
+					}
+
+					[[noreturn]] void serve(const int fd)
+					{
+						const auto bytes = static_cast<const uint8_t *>(segment);
+						uint64_t count;
+
+						while(read_all(fd, &count, sizeof(count)))
+						{
+							std::vector<uint64_t> offsets(count);
+							std::vector<double> results(count);
+
+							if(!read_all(fd, offsets.data(), count * sizeof(uint64_t)))
+							{
+								break;
+							}
+
+							for(uint64_t i = 0; i < count; ++i)
+							{
+								uint64_t length;
+
+								std::memcpy(&length, bytes + offsets[i], sizeof(uint64_t));
+
+								auto genes = reinterpret_cast<const Gene *>(bytes + offsets[i] + sizeof(uint64_t));
+								Chromosome chromosome(genes, genes + length);
+
+								try
+								{
+									results[i] = fn(std::begin(chromosome), std::end(chromosome));
+								}
+								catch(...)
+								{
+									results[i] = fallback;
+								}
+							}
+
+							if(!write_all(fd, results.data(), count * sizeof(double)))
+							{
+								break;
+							}
+						}
+
+						_exit(0);
+					}
+
+					bool send(Worker &w, const std::vector<uint64_t> &offsets)
+					{
+						const uint64_t count = w.last - w.first;
+
+						w.received.resize(count);
+						w.bytes = 0;
+						w.deadline = std::chrono::steady_clock::now() + timeout;
+
+						return write_all(w.fd, &count, sizeof(count))
+						       && write_all(w.fd, offsets.data() + w.first, count * sizeof(uint64_t));
+					}
+
+					// waits for answers or timeouts, returns the number of finished chromosomes:
+					size_t receive(double *out)
+					{
+						std::vector<pollfd> fds;
+						std::vector<Worker *> busy;
+						auto deadline = std::chrono::steady_clock::time_point::max();
+
+						for(auto &w : workers)
+						{
+							if(w.last > w.first)
+							{
+								fds.push_back({ w.fd, POLLIN, 0 });
+								busy.push_back(&w);
+								deadline = std::min(deadline, w.deadline);
+							}
+						}
+
+						if(busy.empty())
+						{
+							return 0;
+						}
+
+						const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+						const int ms = static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(wait.count() + 1, 0, std::numeric_limits<int>::max()));
+
+						if(poll(fds.data(), fds.size(), ms) == -1 && errno != EINTR)
+						{
+							throw std::system_error(errno, std::generic_category(), "poll");
+						}
+
+						size_t done = 0;
+
+						for(size_t i = 0; i < busy.size(); ++i)
+						{
+							Worker &w = *busy[i];
+
+							if(fds[i].revents)
+							{
+								const ssize_t n = recv(w.fd,
+								                       reinterpret_cast<uint8_t *>(w.received.data()) + w.bytes,
+								                       w.received.size() * sizeof(double) - w.bytes,
+								                       MSG_DONTWAIT);
+
+								if(n > 0)
+								{
+									w.bytes += n;
+
+									if(w.bytes == w.received.size() * sizeof(double))
+									{
+										std::copy(begin(w.received), end(w.received), out + w.first);
+										done += w.last - w.first;
+										w.first = w.last;
+									}
+
+									continue;
+								}
+
+								if(n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+								{
+									continue;
+								}
+
+								done += fail(w, out); // connection closed, the worker crashed
+							}
+							else if(std::chrono::steady_clock::now() >= w.deadline)
+							{
+								done += fail(w, out);
+							}
+						}
+
+						return done;
+					}
+
+					// replaces a worker & assigns the fallback value to its chromosomes:
+					size_t fail(Worker &w, double *out)
+					{
+						const size_t count = w.last - w.first;
+
+						std::fill(out + w.first, out + w.last, fallback);
+						++failures;
+
+						terminate(w);
+						w = Worker();
+
+						try
+						{
+							spawn(w);
+						}
+						catch(const std::system_error &)
+						{
+							// the worker stays unavailable until the next call
+						}
+
+						return count;
+					}
+
+					// tries to fork workers which couldn't be replaced before:
+					void revive()
+					{
+						for(auto &w : workers)
+						{
+							if(w.pid <= 0)
+							{
+								try
+								{
+									spawn(w);
+								}
+								catch(const std::system_error &)
+								{
+								}
+							}
+						}
+					}
+
+					void terminate(Worker &w)
+					{
+						if(w.fd != -1)
+						{
+							close(w.fd);
+							w.fd = -1;
+						}
+
+						if(w.pid > 0)
+						{
+							kill(w.pid, SIGKILL);
+							waitpid(w.pid, nullptr, 0);
+							w.pid = -1;
+						}
+					}
+
+					void shutdown()
+					{
+						for(auto &w : workers)
+						{
+							terminate(w);
+						}
+
+						if(segment != MAP_FAILED)
+						{
+							munmap(segment, capacity);
+							segment = MAP_FAILED;
+						}
+					}
+
+					static bool read_all(const int fd, void *buffer, size_t size)
+					{
+						auto p = static_cast<uint8_t *>(buffer);
+
+						while(size > 0)
+						{
+							const ssize_t n = read(fd, p, size);
+
+							if(n <= 0)
+							{
+								if(n == -1 && errno == EINTR)
+								{
+									continue;
+								}
+
+								return false;
+							}
+
+							p += n;
+							size -= n;
+						}
+
+						return true;
+					}
+
+					static bool write_all(const int fd, const void *buffer, size_t size)
+					{
+						auto p = static_cast<const uint8_t *>(buffer);
+
+						while(size > 0)
+						{
+#ifdef MSG_NOSIGNAL
+							const ssize_t n = ::send(fd, p, size, MSG_NOSIGNAL);
+#else
+							const ssize_t n = ::send(fd, p, size, 0);
+#endif
+
+							if(n == -1)
+							{
+								if(errno == EINTR)
+								{
+									continue;
+								}
+
+								return false;
+							}
+
+							p += n;
+							size -= n;
+						}
+
+						return true;
+					}
+			};
+
+			std::shared_ptr<State> state;
+	};
+
+	/**
+	   @tparam Chromosome chromosome type, must be constructible from an iterator range
+	                      of trivially copyable genes
+	   @tparam Compare function to compare fitness values
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	   @param fn a fitness function
+	   @param workers number of worker processes
+	   @param timeout maximum time a worker may spend on a message
+	   @param fallback fitness of chromosomes a worker failed to evaluate
+	   @return new function object
+
+	   Wraps a fitness function to evaluate chromosomes in worker processes.
+	 */
+	template<typename Chromosome, typename Compare = std::greater<double>, typename Fitness>
+	ProcessPool<Chromosome, Fitness, Compare> make_process_pool(Fitness fn,
+	                                                            const size_t workers = std::max<size_t>(std::thread::hardware_concurrency(), 1),
+	                                                            const std::chrono::milliseconds timeout = std::chrono::seconds(60),
+	                                                            const double fallback = ProcessPool<Chromosome, Fitness, Compare>::worst())
+	{
+		return ProcessPool<Chromosome, Fitness, Compare>(fn, workers, timeout, fallback);
+	}
+}
+
+#endif
+
+#endif
@@ -24,14 +24,273 @@
 
 #include <random>
 #include <algorithm>
+#include <numeric>
 #include <vector>
 #include <stdexcept>
 #include <limits>
+#include <cstdint>
+#include <cmath>
 
 namespace ea::random
 {
+	/**
+	   @param x state of the generator
+	   @return next pseudo random number
+
+	   Advances the state of a SplitMix64 generator & returns the next value.
+	   Used to expand and mix seeds.
+	 */
+	constexpr uint64_t splitmix64(uint64_t &x)
+	{
+		uint64_t z = (x += 0x9e3779b97f4a7c15);
+
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+
+		return z ^ (z >> 31);
+	}
+
+	/**
+	   @class Xoshiro256
+	   @brief xoshiro256** pseudo random number generator with jump-ahead support. Meets
+	          the requirements of UniformRandomBitGenerator.
+	 */
+	class Xoshiro256
+	{
+		public:
+			/*! Type of generated numbers. */
+			using result_type = uint64_t;
+
+			/**
+			   @param seed a seed value
+
+			   Creates and seeds the generator.
+			 */
+			explicit Xoshiro256(const uint64_t seed = 0)
+			{
+				this->seed(seed);
+			}
+
+			/**
+			   @param seed a seed value
+
+			   Expands \p seed to the generator's state by using SplitMix64.
+			 */
+			void seed(uint64_t seed)
+			{
+				for(auto &w : s)
+				{
+					w = splitmix64(seed);
+				}
+			}
+
+			/**
+			   @return smallest potentially generated value
+			 */
+			static constexpr result_type min()
+			{
+				return std::numeric_limits<result_type>::min();
+			}
+
+			/**
+			   @return largest potentially generated value
+			 */
+			static constexpr result_type max()
+			{
+				return std::numeric_limits<result_type>::max();
+			}
+
+			/**
+			   @return next pseudo random number
+			 */
+			result_type operator()()
+			{
+				const uint64_t result = rotl(s[1] * 5, 7) * 9;
+				const uint64_t t = s[1] << 17;
+
+				s[2] ^= s[0];
+				s[3] ^= s[1];
+				s[1] ^= s[2];
+				s[0] ^= s[3];
+
+				s[2] ^= t;
+				s[3] = rotl(s[3], 45);
+
+				return result;
+			}
+
+			/**
+			   Advances the state by 2^128 steps. Can be used to generate 2^128
+			   non-overlapping subsequences.
+			 */
+			void jump()
+			{
+				static const uint64_t JUMP[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+
+				jump(JUMP);
+			}
+
+			/**
+			   Advances the state by 2^192 steps. Can be used to generate 2^64
+			   starting points, from each of which jump() generates 2^64
+			   non-overlapping subsequences.
+			 */
+			void long_jump()
+			{
+				static const uint64_t LONG_JUMP[] = { 0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 };
+
+				jump(LONG_JUMP);
+			}
+
+			/**
+			   @param rhs generator to compare
+			   @return true if both generators have the same state
+			 */
+			bool operator==(const Xoshiro256 &rhs) const
+			{
+				return std::equal(std::begin(s), std::end(s), std::begin(rhs.s));
+			}
+
+			/**
+			   @param rhs generator to compare
+			   @return true if the generators have different states
+			 */
+			bool operator!=(const Xoshiro256 &rhs) const
+			{
+				return !(*this == rhs);
+			}
+
+		private:
+			uint64_t s[4];
+
+			static uint64_t rotl(const uint64_t x, const int k)
+			{
+				return (x << k) | (x >> (64 - k));
+			}
+
+			void jump(const uint64_t (&table)[4])
+			{
+				uint64_t t[4] = { 0, 0, 0, 0 };
+
+				for(auto word : table)
+				{
+					for(int b = 0; b < 64; ++b)
+					{
+						if(word & (static_cast<uint64_t>(1) << b))
+						{
+							for(int i = 0; i < 4; ++i)
+							{
+								t[i] ^= s[i];
+							}
+						}
+
+						(*this)();
+					}
+				}
+
+				std::copy(std::begin(t), std::end(t), std::begin(s));
+			}
+	};
+
+	/**
+	   @class Xoshiro256x4
+	   @brief Four interleaved xoshiro256** generators. Numbers are generated block-wise
+	          in a loop the compiler can vectorize (e.g. to AVX2 lanes). Meets the
+	          requirements of UniformRandomBitGenerator.
+	 */
+	class Xoshiro256x4
+	{
+		public:
+			/*! Type of generated numbers. */
+			using result_type = uint64_t;
+
+			/**
+			   @param seed a seed value
+
+			   Creates and seeds the generator.
+			 */
+			explicit Xoshiro256x4(uint64_t seed = 0)
+				: offset(BLOCK_SIZE)
+			{
+				for(size_t lane = 0; lane < LANES; ++lane)
+				{
+					s0[lane] = splitmix64(seed);
+					s1[lane] = splitmix64(seed);
+					s2[lane] = splitmix64(seed);
+					s3[lane] = splitmix64(seed);
+				}
+			}
+
+			/**
+			   @return smallest potentially generated value
+			 */
+			static constexpr result_type min()
+			{
+				return std::numeric_limits<result_type>::min();
+			}
+
+			/**
+			   @return largest potentially generated value
+			 */
+			static constexpr result_type max()
+			{
+				return std::numeric_limits<result_type>::max();
+			}
+
+			/**
+			   @return next pseudo random number
+			 */
+			result_type operator()()
+			{
+				if(offset == BLOCK_SIZE)
+				{
+					refill();
+				}
+
+				return block[offset++];
+			}
+
+		private:
+			static constexpr size_t LANES = 4;
+			static constexpr size_t BLOCK_SIZE = LANES * 16;
+
+			uint64_t s0[LANES];
+			uint64_t s1[LANES];
+			uint64_t s2[LANES];
+			uint64_t s3[LANES];
+			uint64_t block[BLOCK_SIZE];
+			size_t offset;
+
+			void refill()
+			{
+				for(size_t i = 0; i < BLOCK_SIZE; i += LANES)
+				{
+					for(size_t lane = 0; lane < LANES; ++lane)
+					{
+						const uint64_t x = s1[lane] * 5;
+						const uint64_t t = s1[lane] << 17;
+
+						block[i + lane] = ((x << 7) | (x >> 57)) * 9;
+
+						s2[lane] ^= s0[lane];
+						s3[lane] ^= s1[lane];
+						s1[lane] ^= s2[lane];
+						s0[lane] ^= s3[lane];
+
+						s2[lane] ^= t;
+						s3[lane] = (s3[lane] << 45) | (s3[lane] >> 19);
+					}
+				}
+
+				offset = 0;
+			}
+	};
+
 	/*! Default random engine. */
-	using RandomEngine = std::mt19937;
+	using RandomEngine = Xoshiro256;
+
+	/*! Minimum number of values generated block-wise. */
+	const size_t BULK_THRESHOLD = 64;
 
 	/**
 	   @return a new instance of the default random engine
@@ -41,11 +300,241 @@ namespace ea::random
 	RandomEngine default_engine()
 	{
 		std::random_device rd;
-		std::mt19937 mt(rd());
+		const uint64_t seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+
+		return RandomEngine(seed);
+	}
+
+	/**
+	   @param seed a seed value
+	   @param key key of the branch
+	   @return a new seed value
+
+	   Derives the seed of a sub-stream from a parent seed, e.g. the sub-stream of a
+	   generation from the run seed or the sub-stream of an individual from the seed
+	   of a generation. The derived seed depends only on its arguments, so results don't
+	   change with the number of threads drawing from the sub-streams.
+	 */
+	constexpr uint64_t derive_seed(uint64_t seed, uint64_t key)
+	{
+		uint64_t k = splitmix64(key);
+
+		seed ^= k;
 
-		return mt;
+		return splitmix64(seed);
+	}
+
+	/**
+	   @tparam Keys unsigned integer types
+	   @param seed a seed value
+	   @param key key of the first branch
+	   @param keys keys of the following branches
+	   @return a new seed value
+
+	   Derives a seed by walking down a path of the seed tree, e.g.
+	   derive_seed(run, generation, index).
+	 */
+	template<typename... Keys>
+	constexpr uint64_t derive_seed(const uint64_t seed, const uint64_t key, const Keys... keys)
+	{
+		return derive_seed(derive_seed(seed, key), static_cast<uint64_t>(keys)...);
+	}
+
+	/**
+	   @return the calling thread's random engine
+
+	   Returns an instance of the default random engine owned by the calling thread.
+	   The engine is seeded when it's requested for the first time & reused afterwards.
+	 */
+	RandomEngine &thread_engine()
+	{
+		thread_local RandomEngine eng = default_engine();
+
+		return eng;
+	}
+
+	/**
+	   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+	   @param eng random engine
+	   @return 64 random bits
+	 */
+	template<typename Engine>
+	uint64_t bits64(Engine &eng)
+	{
+		if constexpr(Engine::min() == 0 && Engine::max() == std::numeric_limits<uint64_t>::max())
+		{
+			return eng();
+		}
+		else
+		{
+			return std::uniform_int_distribution<uint64_t>()(eng);
+		}
+	}
+
+	/**
+	   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+	   @param eng random engine
+	   @return a random number in [0, 1)
+
+	   Converts the upper 53 bits of a random word to a double.
+	 */
+	template<typename Engine>
+	double canonical(Engine &eng)
+	{
+		return static_cast<double>(bits64(eng) >> 11) * 0x1.0p-53;
+	}
+
+	namespace detail
+	{
+		// layers of the Ziggurat algorithm (Marsaglia & Tsang, Doornik's variant):
+		struct Ziggurat
+		{
+			static constexpr int LAYERS = 128;
+			static constexpr double R = 3.442619855899;
+			static constexpr double V = 9.91256303526217e-3;
+
+			double x[LAYERS + 1];
+			double ratio[LAYERS];
+
+			Ziggurat()
+			{
+				double f = std::exp(-0.5 * R * R);
+
+				x[0] = V / f;
+				x[1] = R;
+				x[LAYERS] = 0.0;
+
+				for(int i = 2; i < LAYERS; ++i)
+				{
+					x[i] = std::sqrt(-2.0 * std::log(V / x[i - 1] + f));
+					f = std::exp(-0.5 * x[i] * x[i]);
+				}
+
+				for(int i = 0; i < LAYERS; ++i)
+				{
+					ratio[i] = x[i + 1] / x[i];
+				}
+			}
+
+			static const Ziggurat &get()
+			{
+				static const Ziggurat ziggurat;
+
+				return ziggurat;
+			}
+		};
+
+		// random number in (0, 1], safe to pass to log():
+		template<typename Engine>
+		double open_canonical(Engine &eng)
+		{
+			return static_cast<double>((bits64(eng) >> 11) + 1) * 0x1.0p-53;
+		}
+	}
+
+	/**
+	   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+	   @param eng random engine
+	   @return a standard normally distributed random number
+
+	   Draws a random number from the standard normal distribution by using the
+	   Ziggurat algorithm. Most numbers need a single random word & no transcendental
+	   function call.
+	 */
+	template<typename Engine>
+	double normal(Engine &eng)
+	{
+		const detail::Ziggurat &z = detail::Ziggurat::get();
+
+		for(;;)
+		{
+			const uint64_t bits = bits64(eng);
+			const double u = 2.0 * (static_cast<double>(bits >> 11) * 0x1.0p-53) - 1.0;
+			const int i = static_cast<int>(bits & (detail::Ziggurat::LAYERS - 1));
+
+			if(std::abs(u) < z.ratio[i])
+			{
+				return u * z.x[i];
+			}
+
+			if(i == 0) // sample from the tail
+			{
+				double x;
+				double y;
+
+				do
+				{
+					x = std::log(detail::open_canonical(eng)) / detail::Ziggurat::R;
+					y = std::log(detail::open_canonical(eng));
+				}
+				while(-2.0 * y < x * x);
+
+				return u < 0.0 ? x - detail::Ziggurat::R : detail::Ziggurat::R - x;
+			}
+
+			const double x = u * z.x[i];
+			const double f0 = std::exp(-0.5 * (z.x[i] * z.x[i] - x * x));
+			const double f1 = std::exp(-0.5 * (z.x[i + 1] * z.x[i + 1] - x * x));
+
+			if(f1 + canonical(eng) * (f0 - f1) < 1.0)
+			{
+				return x;
+			}
+		}
+	}
+
+	/**
+	   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+	   @tparam F a function object: void fun(UniformRandomBitGenerator &eng)
+	   @param count number of random values the function object is going to draw
+	   @param eng random engine
+	   @param fn function object to invoke
+
+	   Invokes \p fn with a random engine suitable to draw \p count values. Large
+	   amounts of numbers are drawn block-wise from a Xoshiro256x4 engine seeded
+	   by \p eng.
+	 */
+	template<typename Engine, typename F>
+	void with_bulk_engine(const size_t count, Engine &eng, F fn)
+	{
+		if(count >= BULK_THRESHOLD)
+		{
+			Xoshiro256x4 lanes(bits64(eng));
+
+			fn(lanes);
+		}
+		else
+		{
+			fn(eng);
+		}
 	}
 
+	/**
+	   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+	   @tparam T the type of numbers generated
+	   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+	   @param first iterator pointing to the first element of the range
+	   @param count number of values to generate
+	   @param min minimum potentially generated value
+	   @param max maximum potentially generated value
+	   @param eng random engine
+
+	   Writes \p count random integer values to a destination range.
+	 */
+	template<typename OutputIterator, typename T, typename Engine>
+	void fill_n_int(OutputIterator first, const size_t count, const T min, const T max, Engine &eng)
+	{
+		with_bulk_engine(count, eng, [&](auto &gen)
+		{
+			std::uniform_int_distribution<T> dist(min, max);
+
+			std::generate_n(first, count, [&dist, &gen]()
+			{
+				return dist(gen);
+			});
+		});
+	};
+
 	/**
 	   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
 	   @tparam T the type of numbers generated
@@ -59,12 +548,35 @@ namespace ea::random
 	template<typename OutputIterator, typename T>
 	void fill_n_int(OutputIterator first, const size_t count, const T min, const T max)
 	{
-		RandomEngine eng = default_engine();
-		std::uniform_int_distribution<T> dist(min, max);
+		fill_n_int(first, count, min, max, thread_engine());
+	}
 
-		std::generate_n(first, count, [&dist, &eng]()
+	/**
+	   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+	   @tparam T the type of numbers generated
+	   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+	   @param first iterator pointing to the first element of the range
+	   @param count number of values to generate
+	   @param min minimum potentially generated value
+	   @param max maximum potentially generated value
+	   @param eng random engine
+
+	   Writes \p count random floating-point values to a destination range.
+	 */
+	template<typename OutputIterator, typename T, typename Engine>
+	void fill_n_real(OutputIterator first, const size_t count, const T min, const T max, Engine &eng)
+	{
+		with_bulk_engine(count, eng, [&](auto &gen)
 		{
-			return dist(eng);
+			const double width = static_cast<double>(max) - static_cast<double>(min);
+
+			std::generate_n(first, count, [&]()
+			{
+				const T n = static_cast<T>(min + canonical(gen) * width);
+
+				// rounding may hit the open upper bound:
+				return n < max ? n : std::nextafter(max, min);
+			});
 		});
 	};
 
@@ -81,12 +593,30 @@ namespace ea::random
 	template<typename OutputIterator, typename T>
 	void fill_n_real(OutputIterator first, const size_t count, const T min, const T max)
 	{
-		RandomEngine eng = default_engine();
-		std::uniform_real_distribution<T> dist(min, max);
+		fill_n_real(first, count, min, max, thread_engine());
+	}
+
+	/**
+	   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+	   @tparam T the type of numbers generated
+	   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+	   @param first iterator pointing to the first element of the range
+	   @param count number of values to generate
+	   @param mean mean of the normal distribution
+	   @param stddev standard deviation of the normal distribution
+	   @param eng random engine
 
-		std::generate_n(first, count, [&dist, &eng]()
+	   Writes \p count normally distributed random values to a destination range.
+	 */
+	template<typename OutputIterator, typename T, typename Engine>
+	void fill_n_normal(OutputIterator first, const size_t count, const T mean, const T stddev, Engine &eng)
+	{
+		with_bulk_engine(count, eng, [&](auto &gen)
 		{
-			return dist(eng);
+			std::generate_n(first, count, [&]()
+			{
+				return static_cast<T>(mean + stddev * normal(gen));
+			});
 		});
 	};
 
@@ -95,15 +625,330 @@ namespace ea::random
 	   @tparam T the type of numbers generated
 	   @param first iterator pointing to the first element of the range
 	   @param count number of values to generate
+	   @param mean mean of the normal distribution
+	   @param stddev standard deviation of the normal distribution
+
+	   Writes \p count normally distributed random values to a destination range.
+	 */
+	template<typename OutputIterator, typename T>
+	void fill_n_normal(OutputIterator first, const size_t count, const T mean, const T stddev)
+	{
+		fill_n_normal(first, count, mean, stddev, thread_engine());
+	}
+
+	/**
+	   @enum BernoulliSampling
+	   @brief Algorithm used to perform a sequence of Bernoulli trials.
+	 */
+	enum class BernoulliSampling
+	{
+		/*! Skips trials if the success probability is small (see SKIP_PROBABILITY). */
+		automatic,
+		/*! Draws a random number for each trial, O(number of trials). */
+		sequential,
+		/*! Jumps to the next success by drawing geometrically distributed gaps, O(number of successes). */
+		skip
+	};
+
+	/*! Success probabilities below this value are sampled by skipping trials. */
+	const double SKIP_PROBABILITY = 0.1;
+
+	namespace detail
+	{
+		// number of failures before the next success (log_q = log(1 - p)):
+		template<typename Engine>
+		size_t geometric_gap(const double log_q, Engine &eng)
+		{
+			const double gap = std::floor(std::log(open_canonical(eng)) / log_q);
+
+			return gap < static_cast<double>(std::numeric_limits<size_t>::max())
+				? static_cast<size_t>(gap)
+				: std::numeric_limits<size_t>::max();
+		}
+	}
+
+	/**
+	   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+	   @tparam F a function object: void fun(size_t offset)
+	   @param count number of trials
+	   @param probability success probability of a single trial (0.0 < p < 1.0)
+	   @param eng random engine
+	   @param fn function object invoked with the offset of each successful trial
+	   @param sampling algorithm used to perform the trials
+	   @param at_least_one repeat the experiment until at least one trial succeeds
+
+	   Performs \p count Bernoulli trials & invokes \p fn with the offsets of the
+	   successful ones in ascending order. If the experiment is repeated offsets
+	   start over.
+
+	   When skipping, the first success of an experiment conditioned on at least
+	   one success is drawn from the truncated geometric distribution. Subsequent
+	   gaps follow the ordinary geometric distribution.
+	 */
+	template<typename Engine, typename F>
+	void bernoulli_trials(const size_t count,
+	                      const double probability,
+	                      Engine &eng,
+	                      F fn,
+	                      const BernoulliSampling sampling = BernoulliSampling::automatic,
+	                      const bool at_least_one = false)
+	{
+		if(count == 0)
+		{
+			return;
+		}
+
+		if(sampling == BernoulliSampling::sequential
+		   || (sampling == BernoulliSampling::automatic && probability >= SKIP_PROBABILITY))
+		{
+			with_bulk_engine(count, eng, [&](auto &gen)
+			{
+				bool succeeded = false;
+
+				do
+				{
+					for(size_t i = 0; i < count; ++i)
+					{
+						if(canonical(gen) <= probability)
+						{
+							fn(i);
+							succeeded = true;
+						}
+					}
+				} while(at_least_one && !succeeded);
+			});
+		}
+		else
+		{
+			const double log_q = std::log1p(-probability);
+			size_t offset = 0;
+
+			if(at_least_one)
+			{
+				// P(at least one success) = 1 - (1 - p)^count:
+				const double p_any = -std::expm1(static_cast<double>(count) * log_q);
+				const double first = std::floor(std::log1p(-canonical(eng) * p_any) / log_q);
+
+				offset = first < static_cast<double>(count - 1) ? static_cast<size_t>(first) : count - 1;
+				fn(offset++);
+			}
+
+			while(offset < count)
+			{
+				const size_t gap = detail::geometric_gap(log_q, eng);
+
+				if(gap >= count - offset)
+				{
+					break;
+				}
+
+				offset += gap;
+				fn(offset++);
+			}
+		}
+	}
+
+	/**
+	   @tparam F a function object: void fun(size_t offset)
+	   @param count number of trials
+	   @param probability success probability of a single trial (0.0 < p < 1.0)
+	   @param fn function object invoked with the offset of each successful trial
+	   @param sampling algorithm used to perform the trials
+	   @param at_least_one repeat the experiment until at least one trial succeeds
+
+	   Performs \p count Bernoulli trials & invokes \p fn with the offsets of the
+	   successful ones in ascending order.
+	 */
+	template<typename F>
+	void bernoulli_trials(const size_t count,
+	                      const double probability,
+	                      F fn,
+	                      const BernoulliSampling sampling = BernoulliSampling::automatic,
+	                      const bool at_least_one = false)
+	{
+		bernoulli_trials(count, probability, thread_engine(), fn, sampling, at_least_one);
+	}
+
+	/**
+	   @enum DistinctSampling
+	   @brief Algorithm used to draw distinct random integers.
+	 */
+	enum class DistinctSampling
+	{
+		/*! Chooses an algorithm depending on the number of values & the size of the interval. */
+		automatic,
+		/*! Draws values until \p count distinct values are found. Fast for a few values. */
+		rejection,
+		/*! Robert Floyd's algorithm, O(count). Suited for values drawn from a large interval. */
+		floyd,
+		/*! Partial Fisher-Yates shuffle, O(interval size). Suited for values covering most of the interval. */
+		shuffle
+	};
+
+	namespace detail
+	{
+		// small open-addressing set storing offsets of drawn numbers, slots are
+		// reused per thread to avoid an allocation on each call:
+		class OffsetSet
+		{
+			public:
+				explicit OffsetSet(const size_t count)
+					: slots(buffer())
+				{
+					size_t capacity = 16;
+
+					while(capacity < count * 2)
+					{
+						capacity <<= 1;
+					}
+
+					slots.assign(capacity, EMPTY);
+					mask = capacity - 1;
+				}
+
+				bool insert(const uint64_t offset)
+				{
+					bool inserted = false;
+					size_t i = hash(offset);
+
+					while(!inserted && slots[i] != offset)
+					{
+						if(slots[i] == EMPTY)
+						{
+							slots[i] = offset;
+							inserted = true;
+						}
+						else
+						{
+							i = (i + 1) & mask;
+						}
+					}
+
+					return inserted;
+				}
+
+			private:
+				static constexpr uint64_t EMPTY = std::numeric_limits<uint64_t>::max();
+
+				std::vector<uint64_t> &slots;
+				size_t mask;
+
+				static std::vector<uint64_t> &buffer()
+				{
+					thread_local std::vector<uint64_t> slots;
+
+					return slots;
+				}
+
+				size_t hash(const uint64_t offset) const
+				{
+					return static_cast<size_t>((offset * 0x9e3779b97f4a7c15) >> 32) & mask;
+				}
+		};
+
+		template<typename Engine>
+		void sample_rejection(std::vector<uint64_t> &offsets, const size_t count, const uint64_t distance, Engine &eng)
+		{
+			std::uniform_int_distribution<uint64_t> dist(0, distance);
+
+			if(count <= 16)
+			{
+				while(offsets.size() != count)
+				{
+					const uint64_t n = dist(eng);
+
+					if(std::find(begin(offsets), end(offsets), n) == end(offsets))
+					{
+						offsets.push_back(n);
+					}
+				}
+			}
+			else
+			{
+				OffsetSet set(count);
+
+				while(offsets.size() != count)
+				{
+					const uint64_t n = dist(eng);
+
+					if(set.insert(n))
+					{
+						offsets.push_back(n);
+					}
+				}
+			}
+		}
+
+		template<typename Engine>
+		void sample_floyd(std::vector<uint64_t> &offsets, const size_t count, const uint64_t distance, Engine &eng)
+		{
+			OffsetSet set(count);
+
+			for(uint64_t j = distance - (count - 1); ; ++j)
+			{
+				const uint64_t t = std::uniform_int_distribution<uint64_t>(0, j)(eng);
+
+				if(set.insert(t))
+				{
+					offsets.push_back(t);
+				}
+				else
+				{
+					set.insert(j);
+					offsets.push_back(j);
+				}
+
+				if(j == distance)
+				{
+					break;
+				}
+			}
+
+			// Floyd's algorithm draws a random subset, shuffle it to get a random order:
+			std::shuffle(begin(offsets), end(offsets), eng);
+		}
+
+		template<typename Engine>
+		void sample_shuffle(std::vector<uint64_t> &offsets, const size_t count, const uint64_t distance, Engine &eng)
+		{
+			thread_local std::vector<uint64_t> scratch;
+
+			scratch.resize(distance + 1);
+			std::iota(begin(scratch), end(scratch), 0);
+
+			for(size_t i = 0; i < count; ++i)
+			{
+				const uint64_t j = std::uniform_int_distribution<uint64_t>(i, distance)(eng);
+
+				std::swap(scratch[i], scratch[j]);
+			}
+
+			offsets.assign(begin(scratch), begin(scratch) + count);
+		}
+	}
+
+	/**
+	   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+	   @tparam T the type of numbers generated
+	   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+	   @param first iterator pointing to the first element of the range
+	   @param count number of values to generate
 	   @param min minimum potentially generated value
 	   @param max maximum potentially generated value
+	   @param eng random engine
+	   @param sampling sampling algorithm
 
 	   Writes a distinct collection of \p count random integer values to a destination range.
 
 	   Throws std::invalid_argument or std::overflow_error if the specified range is invalid.
 	 */
-	template<typename OutputIterator, typename T>
-	void fill_distinct_n_int(OutputIterator first, const size_t count, const T min, const T max)
+	template<typename OutputIterator, typename T, typename Engine>
+	void fill_distinct_n_int(OutputIterator first,
+	                         const size_t count,
+	                         const T min,
+	                         const T max,
+	                         Engine &eng,
+	                         const DistinctSampling sampling = DistinctSampling::automatic)
 	{
 		if(count > 0)
 		{
@@ -127,23 +972,69 @@ namespace ea::random
 				throw std::invalid_argument("Number range too small.");
 			}
 
-			RandomEngine eng = default_engine();
-			std::uniform_int_distribution<T> dist(min, max);
-			std::vector<T> numbers;
+			const uint64_t d = static_cast<uint64_t>(distance);
+			DistinctSampling algorithm = sampling;
 
-			while(numbers.size() != count)
+			if(algorithm == DistinctSampling::automatic)
 			{
-				int n = dist(eng);
-
-				if(std::find(begin(numbers), end(numbers), n) == end(numbers))
+				if(count <= 16)
+				{
+					algorithm = DistinctSampling::rejection;
+				}
+				else if(d / 2 < count)
 				{
-					numbers.push_back(n);
+					algorithm = DistinctSampling::shuffle;
 				}
+				else
+				{
+					algorithm = DistinctSampling::floyd;
+				}
+			}
+
+			// reused per thread, so drawing numbers doesn't allocate memory after the first call:
+			thread_local std::vector<uint64_t> offsets;
+
+			offsets.clear();
+			offsets.reserve(count);
+
+			switch(algorithm)
+			{
+				case DistinctSampling::shuffle:
+					detail::sample_shuffle(offsets, count, d, eng);
+					break;
+
+				case DistinctSampling::floyd:
+					detail::sample_floyd(offsets, count, d, eng);
+					break;
+
+				default:
+					detail::sample_rejection(offsets, count, d, eng);
 			}
 
-			std::copy(begin(numbers), end(numbers), first);
+			std::transform(begin(offsets), end(offsets), first, [min](const uint64_t offset)
+			{
+				return static_cast<T>(min + static_cast<T>(offset));
+			});
 		}
 	};
+
+	/**
+	   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+	   @tparam T the type of numbers generated
+	   @param first iterator pointing to the first element of the range
+	   @param count number of values to generate
+	   @param min minimum potentially generated value
+	   @param max maximum potentially generated value
+
+	   Writes a distinct collection of \p count random integer values to a destination range.
+
+	   Throws std::invalid_argument or std::overflow_error if the specified range is invalid.
+	 */
+	template<typename OutputIterator, typename T>
+	void fill_distinct_n_int(OutputIterator first, const size_t count, const T min, const T max)
+	{
+		fill_distinct_n_int(first, count, min, max, thread_engine());
+	}
 }
 
 #endif
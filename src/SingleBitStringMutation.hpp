@@ -47,6 +47,23 @@ namespace ea::mutation
 			 */
 			template<typename InputIterator>
 			void operator()(InputIterator first, InputIterator last) const
+			{
+				(*this)(first, last, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyInputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first points to the first element of a chromosome
+			   @param last points to the end of a chromosome
+			   @param eng random engine
+
+			   Flips a random gene.
+
+			   Throws std::length_error if chromosome is empty.
+			 */
+			template<typename InputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, Engine &eng) const
 			{
 				const auto length = std::distance(first, last);
 	
@@ -55,7 +72,6 @@ namespace ea::mutation
 					throw std::length_error("Chromosome is empty.");
 				}
 
-				random::RandomEngine eng = random::default_engine();
 				std::uniform_int_distribution<decltype(length)> dist(0, length - 1);
 
 				const auto offset = dist(eng);
@@ -27,6 +27,7 @@
 #include <stdexcept>
 
 #include "Random.hpp"
+#include "Fitness.hpp"
 
 namespace ea::mutation
 {
@@ -48,6 +49,59 @@ namespace ea::mutation
 			 */
 			template<typename InputIterator>
 			void operator()(InputIterator first, InputIterator last) const
+			{
+				(*this)(first, last, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first points to the first element of a chromosome
+			   @param last points to the end of a chromosome
+			   @param eng random engine
+
+			   Swaps two genes.
+
+			   Throws std::length_error if the chromosome contains less than two genes.
+			 */
+			template<typename InputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, Engine &eng) const
+			{
+				swap(first, choose(first, last, eng));
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @param first points to the first element of a chromosome
+			   @param last points to the end of a chromosome
+			   @param eng random engine
+			   @param changes beginning of the destination range receiving the overwritten genes (fitness::Change)
+
+			   Swaps two genes & reports them to support incremental fitness evaluation.
+
+			   Throws std::length_error if the chromosome contains less than two genes.
+			 */
+			template<typename InputIterator, typename Engine, typename OutputIterator>
+			void operator()(InputIterator first, InputIterator last, Engine &eng, OutputIterator changes) const
+			{
+				using Gene = typename std::iterator_traits<InputIterator>::value_type;
+
+				const auto indeces = choose(first, last, eng);
+
+				for(auto i : indeces)
+				{
+					*changes++ = fitness::Change<Gene> { static_cast<size_t>(i), *(first + i) };
+				}
+
+				swap(first, indeces);
+			}
+
+		private:
+			template<typename InputIterator, typename Engine>
+			static std::vector<typename std::iterator_traits<InputIterator>::difference_type>
+			choose(InputIterator first, InputIterator last, Engine &eng)
 			{
 				using difference_type = typename std::iterator_traits<InputIterator>::difference_type;
 
@@ -60,8 +114,14 @@ namespace ea::mutation
 
 				std::vector<difference_type> indeces(2);
 
-				random::fill_distinct_n_int(begin(indeces), 2, static_cast<difference_type>(0), length - 1);
+				random::fill_distinct_n_int(begin(indeces), 2, static_cast<difference_type>(0), length - 1, eng);
 
+				return indeces;
+			}
+
+			template<typename InputIterator, typename Indeces>
+			static void swap(InputIterator first, const Indeces &indeces)
+			{
 				auto chromosome = *(first + indeces[0]);
 
 				*(first + indeces[0]) = *(first + indeces[1]);
@@ -71,4 +131,3 @@ namespace ea::mutation
 }
 
 #endif
-
@@ -0,0 +1,528 @@
+/***************************************************************************
+    begin........: October 2026
+    copyright....: Sebastian Fedrau
+    email........: sebastian.fedrau@gmail.com
+ ***************************************************************************/
+
+/***************************************************************************
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License v3 as published by
+    the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License v3 for more details.
+ ***************************************************************************/
+/**
+   @file Statistics.hpp
+   @brief Streaming statistics with constant memory.
+   @author Sebastian Fedrau <sebastian.fedrau@gmail.com>
+ */
+#ifndef EA_STATISTICS_HPP
+#define EA_STATISTICS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace ea::statistics
+{
+	/**
+	   @class Moments
+	   @brief Running count, mean, variance, minimum & maximum (Welford's algorithm).
+	 */
+	class Moments
+	{
+		public:
+			/**
+			   @param value value to add
+			 */
+			void add(const double value)
+			{
+				++n;
+
+				const double delta = value - m;
+
+				m += delta / n;
+				m2 += delta * (value - m);
+				lowest = std::min(lowest, value);
+				highest = std::max(highest, value);
+			}
+
+			/**
+			   @param other accumulator to merge
+
+			   Adds the values of another accumulator (Chan's parallel algorithm).
+			 */
+			void merge(const Moments &other)
+			{
+				if(other.n == 0)
+				{
+					return;
+				}
+
+				if(n == 0)
+				{
+					*this = other;
+
+					return;
+				}
+
+				const uint64_t total = n + other.n;
+				const double delta = other.m - m;
+
+				m += delta * other.n / total;
+				m2 += other.m2 + delta * delta * (static_cast<double>(n) * other.n / total);
+				n = total;
+				lowest = std::min(lowest, other.lowest);
+				highest = std::max(highest, other.highest);
+			}
+
+			/**
+			   @return number of added values
+			 */
+			uint64_t count() const
+			{
+				return n;
+			}
+
+			/**
+			   @return mean, NaN if no value has been added
+			 */
+			double mean() const
+			{
+				return n > 0 ? m : std::numeric_limits<double>::quiet_NaN();
+			}
+
+			/**
+			   @return population variance, NaN if no value has been added
+			 */
+			double variance() const
+			{
+				return n > 0 ? m2 / n : std::numeric_limits<double>::quiet_NaN();
+			}
+
+			/**
+			   @return lowest added value, NaN if no value has been added
+			 */
+			double min() const
+			{
+				return n > 0 ? lowest : std::numeric_limits<double>::quiet_NaN();
+			}
+
+			/**
+			   @return highest added value, NaN if no value has been added
+			 */
+			double max() const
+			{
+				return n > 0 ? highest : std::numeric_limits<double>::quiet_NaN();
+			}
+
+		private:
+			uint64_t n = 0;
+			double m = 0.0;
+			double m2 = 0.0;
+			double lowest = std::numeric_limits<double>::infinity();
+			double highest = -std::numeric_limits<double>::infinity();
+	};
+
+	/**
+	   @class TDigest
+	   @brief Estimates quantiles of a stream of values (merging t-digest).
+
+	   Values are collected in a buffer & merged into weighted centroids. The
+	   compression parameter bounds the number of centroids, small & large
+	   quantiles are estimated more precisely than the median.
+	 */
+	class TDigest
+	{
+		public:
+			/**
+			   @param compression accuracy parameter, roughly the maximum number of centroids
+
+			   Throws std::invalid_argument if \p compression is less than one.
+			 */
+			explicit TDigest(const double compression = 100.0)
+				: compression(compression)
+			{
+				if(!(compression >= 1.0))
+				{
+					throw std::invalid_argument("Compression cannot be less than one.");
+				}
+
+				buffer.reserve(capacity());
+			}
+
+			/**
+			   @param value value to add
+			 */
+			void add(const double value)
+			{
+				buffer.push_back({ value, 1.0 });
+				lowest = std::min(lowest, value);
+				highest = std::max(highest, value);
+
+				if(buffer.size() >= capacity())
+				{
+					compress();
+				}
+			}
+
+			/**
+			   @param other digest to merge
+
+			   Adds the centroids of another digest.
+			 */
+			void merge(const TDigest &other)
+			{
+				buffer.insert(std::end(buffer), std::begin(other.centroids), std::end(other.centroids));
+				buffer.insert(std::end(buffer), std::begin(other.buffer), std::end(other.buffer));
+				lowest = std::min(lowest, other.lowest);
+				highest = std::max(highest, other.highest);
+
+				compress();
+			}
+
+			/**
+			   @param q probability (0..1)
+			   @return estimated quantile, NaN if no value has been added
+
+			   Throws std::invalid_argument if \p q is out of range.
+			 */
+			double quantile(const double q)
+			{
+				if(!(q >= 0.0 && q <= 1.0))
+				{
+					throw std::invalid_argument("Probability out of range.");
+				}
+
+				compress();
+
+				if(centroids.empty())
+				{
+					return std::numeric_limits<double>::quiet_NaN();
+				}
+
+				const double index = q * weight;
+
+				// the first half of the first centroid is interpolated from the minimum:
+				if(index < centroids.front().weight / 2.0)
+				{
+					return interpolate(lowest, centroids.front().mean, index / (centroids.front().weight / 2.0));
+				}
+
+				double cumulative = 0.0;
+
+				for(size_t i = 0; i + 1 < centroids.size(); ++i)
+				{
+					const double center = cumulative + centroids[i].weight / 2.0;
+					const double next = cumulative + centroids[i].weight + centroids[i + 1].weight / 2.0;
+
+					if(index < next)
+					{
+						return interpolate(centroids[i].mean, centroids[i + 1].mean, (index - center) / (next - center));
+					}
+
+					cumulative += centroids[i].weight;
+				}
+
+				const Centroid &last = centroids.back();
+				const double center = weight - last.weight / 2.0;
+
+				return interpolate(last.mean, highest, std::min((index - center) / (last.weight / 2.0), 1.0));
+			}
+
+			/**
+			   @return number of added values
+			 */
+			uint64_t count() const
+			{
+				double total = weight;
+
+				for(const Centroid &c : buffer)
+				{
+					total += c.weight;
+				}
+
+				return static_cast<uint64_t>(total);
+			}
+
+			/**
+			   @return number of centroids after compressing the buffer
+			 */
+			size_t size()
+			{
+				compress();
+
+				return centroids.size();
+			}
+
+		private:
+			struct Centroid
+			{
+				double mean;
+				double weight;
+
+				bool operator<(const Centroid &rhs) const
+				{
+					return mean < rhs.mean;
+				}
+			};
+
+			double compression;
+			std::vector<Centroid> centroids;
+			std::vector<Centroid> buffer;
+			double weight = 0.0;
+			double lowest = std::numeric_limits<double>::infinity();
+			double highest = -std::numeric_limits<double>::infinity();
+
+			size_t capacity() const
+			{
+				return static_cast<size_t>(compression) * 5;
+			}
+
+			static double interpolate(const double a, const double b, const double t)
+			{
+				return a + (b - a) * std::max(t, 0.0);
+			}
+
+			static constexpr double PI = 3.14159265358979323846;
+
+			// scale function k1, centroids near the tails cover fewer values:
+			double k(const double q) const
+			{
+				return compression / (2.0 * PI) * std::asin(2.0 * q - 1.0);
+			}
+
+			double k_inverse(const double k) const
+			{
+				return (std::sin(std::min(k * 2.0 * PI / compression, PI / 2.0)) + 1.0) / 2.0;
+			}
+
+			void compress()
+			{
+				if(buffer.empty())
+				{
+					return;
+				}
+
+				buffer.insert(std::end(buffer), std::begin(centroids), std::end(centroids));
+				std::sort(std::begin(buffer), std::end(buffer));
+
+				double total = 0.0;
+
+				for(const Centroid &c : buffer)
+				{
+					total += c.weight;
+				}
+
+				centroids.clear();
+
+				Centroid current = buffer.front();
+				double before = 0.0; // weight of the emitted centroids
+				double limit = total * k_inverse(k(0.0) + 1.0);
+
+				for(size_t i = 1; i < buffer.size(); ++i)
+				{
+					const Centroid &next = buffer[i];
+
+					if(before + current.weight + next.weight <= limit)
+					{
+						current.mean += (next.mean - current.mean) * next.weight / (current.weight + next.weight);
+						current.weight += next.weight;
+					}
+					else
+					{
+						before += current.weight;
+						centroids.push_back(current);
+						limit = total * k_inverse(k(before / total) + 1.0);
+						current = next;
+					}
+				}
+
+				centroids.push_back(current);
+				weight = total;
+				buffer.clear();
+			}
+	};
+
+	/**
+	   @class Accumulator
+	   @brief Combines Moments & TDigest.
+	 */
+	class Accumulator
+	{
+		public:
+			/**
+			   @param compression accuracy parameter of the quantile estimation
+
+			   Throws std::invalid_argument if \p compression is less than one.
+			 */
+			explicit Accumulator(const double compression = 100.0)
+				: digest(compression)
+			{}
+
+			/**
+			   @param value value to add
+			 */
+			void add(const double value)
+			{
+				moments.add(value);
+				digest.add(value);
+			}
+
+			/**
+			   @param other accumulator to merge
+			 */
+			void merge(const Accumulator &other)
+			{
+				moments.merge(other.moments);
+				digest.merge(other.digest);
+			}
+
+			/**
+			   @return number of added values
+			 */
+			uint64_t count() const
+			{
+				return moments.count();
+			}
+
+			/**
+			   @return mean, NaN if no value has been added
+			 */
+			double mean() const
+			{
+				return moments.mean();
+			}
+
+			/**
+			   @return population variance, NaN if no value has been added
+			 */
+			double variance() const
+			{
+				return moments.variance();
+			}
+
+			/**
+			   @return lowest added value, NaN if no value has been added
+			 */
+			double min() const
+			{
+				return moments.min();
+			}
+
+			/**
+			   @return highest added value, NaN if no value has been added
+			 */
+			double max() const
+			{
+				return moments.max();
+			}
+
+			/**
+			   @return estimated median, NaN if no value has been added
+			 */
+			double median()
+			{
+				return digest.quantile(0.5);
+			}
+
+			/**
+			   @param q probability (0..1)
+			   @return estimated quantile, NaN if no value has been added
+
+			   Throws std::invalid_argument if \p q is out of range.
+			 */
+			double quantile(const double q)
+			{
+				return digest.quantile(q);
+			}
+
+		private:
+			Moments moments;
+			TDigest digest;
+	};
+
+	/**
+	   @tparam PopulationIterator must meet the requirements of LegacyInputIterator
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	   @param first iterator pointing to the first chromosome of a population
+	   @param last iterator pointing to the end (element after the last element) of a population
+	   @param fn a fitness function
+	   @param compression accuracy parameter of the quantile estimation
+	   @return accumulated fitness statistics
+
+	   Evaluates each chromosome once & accumulates the fitness values without
+	   storing them. Populations with random access iterators are evaluated in
+	   parallel, each thread fills its own accumulator and the accumulators are
+	   merged in thread order. Other ranges are read in a single pass.
+
+	   Throws std::invalid_argument if \p compression is less than one.
+	 */
+	template<typename PopulationIterator, typename Fitness>
+	Accumulator accumulate(PopulationIterator first, PopulationIterator last, Fitness fn, const double compression = 100.0)
+	{
+		Accumulator result(compression);
+
+		if constexpr(std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<PopulationIterator>::iterator_category>)
+		{
+			const auto length = std::distance(first, last);
+			std::vector<Accumulator> partial;
+
+			#pragma omp parallel
+			{
+				#pragma omp single
+				{
+#ifdef _OPENMP
+					partial.resize(omp_get_num_threads(), Accumulator(compression));
+#else
+					partial.resize(1, Accumulator(compression));
+#endif
+				}
+
+#ifdef _OPENMP
+				Accumulator &accumulator = partial[omp_get_thread_num()];
+#else
+				Accumulator &accumulator = partial[0];
+#endif
+
+				#pragma omp for schedule(static)
+				for(typename std::remove_const<decltype(length)>::type i = 0; i < length; ++i)
+				{
+					auto &chromosome = *(first + i);
+
+					accumulator.add(fn(std::begin(chromosome), std::end(chromosome)));
+				}
+			}
+
+			for(const Accumulator &accumulator : partial)
+			{
+				result.merge(accumulator);
+			}
+		}
+		else
+		{
+			for(; first != last; ++first)
+			{
+				auto &&chromosome = *first;
+
+				result.add(fn(std::begin(chromosome), std::end(chromosome)));
+			}
+		}
+
+		return result;
+	}
+}
+
+#endif
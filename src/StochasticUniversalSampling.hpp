@@ -27,13 +27,14 @@
 #include <iterator>
 #include <stdexcept>
 #include <vector>
-#include <complex>
+#include <cmath>
+#include <random>
 #include <numeric>
 #include <limits>
 #include <algorithm>
-#include <cfenv>
 
 #include "Random.hpp"
+#include "Fitness.hpp"
 #include "Utils.hpp"
 
 namespace ea::selection
@@ -46,8 +47,12 @@ namespace ea::selection
 	class StochasticUniversalSampling
 	{
 		public:
+			/*! Fitness values can be passed as fitness::FitnessTable (see fitness::accepts_fitness_table_v). */
+			static constexpr bool accepts_fitness_table = true;
+
 			/**
 			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
 			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
 			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
 			   @param first first individual of a population
@@ -64,78 +69,273 @@ namespace ea::selection
 			template<typename InputIterator, typename Fitness, typename OutputIterator>
 			void operator()(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
 			{
-				std::vector<double> sums;
+				select_indices(first, last, N, fitness, utils::make_gather_iterator(first, result));
+			}
+
+			/**
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from a population and copies them to \p result.
+
+			   Throws std::length_error if population is empty or std::overflow_error if an
+			   overflow occurs.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, fitness, utils::make_gather_iterator(first, result), eng);
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from an evaluated population and copies them to \p result.
+
+			   Throws std::length_error if population is empty or the table doesn't match the
+			   population size and std::overflow_error if an overflow occurs.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result) const
+			{
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result));
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from an evaluated population and copies them to \p result.
+
+			   The cumulative fitness values are computed with a parallel prefix sum. The
+			   pointers are assigned in chunks, each chunk walks forward from its first
+			   pointer. Individuals are copied in the order of the pointers, the result
+			   only depends on the random engine.
+
+			   Throws std::length_error if population is empty or the table doesn't match the
+			   population size and std::overflow_error if an overflow occurs.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result), eng);
+			}
+
+			/**
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from a population and writes their indices to \p result.
+
+			   Throws std::length_error if population is empty or std::overflow_error if an
+			   overflow occurs.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
+			{
+				select_indices(first, last, N, fitness, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from a population and writes their indices to \p result.
+
+			   Throws std::length_error if population is empty or std::overflow_error if an
+			   overflow occurs.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator, typename Engine>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, fitness::FitnessTable(first, last, fitness), result, eng);
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from an evaluated population and writes their indices to \p result.
+
+			   Throws std::length_error if population is empty or the table doesn't match the
+			   population size and std::overflow_error if an overflow occurs.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result) const
+			{
+				select_indices(first, last, N, table, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from an evaluated population and writes their indices to \p result.
+
+			   The cumulative fitness values are computed with a parallel prefix sum. The
+			   pointers are assigned in chunks, each chunk walks forward from its first
+			   pointer. Individuals are copied in the order of the pointers, the result
+			   only depends on the random engine.
+
+			   Throws std::length_error if population is empty or the table doesn't match the
+			   population size and std::overflow_error if an overflow occurs.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result, Engine &eng) const
+			{
+				fitness::check_table_size(table, std::distance(first, last));
 
-				const double min = collect(first, last, fitness, std::back_inserter(sums));
+				const size_t length = table.size();
 
-				if(N > 0 && sums.size() == 0)
+				if(N > 0 && length == 0)
 				{
 					throw std::length_error("Population is empty.");
 				}
 
-				const double total = accumulate(begin(sums), end(sums), min);
+				if(N == 0)
+				{
+					return;
+				}
+
+				const std::vector<double> sums = accumulate(table);
+				const double total = sums.back();
 
-				random::RandomEngine eng = random::default_engine();
 				std::uniform_real_distribution<double> dist(0.0, total / N);
 
-				double u = dist(eng);
-				auto upper = begin(sums);
+				const double u = dist(eng);
+				const double step = total / N;
+				std::vector<size_t> indices(N);
+
+				// pointers are monotonic: each chunk searches its first pointer, then walks forward
+				const size_t chunks = (N + BLOCK_SIZE - 1) / BLOCK_SIZE;
 
-				utils::repeat(N, [&]()
+				#pragma omp parallel for
+				for(size_t c = 0; c < chunks; ++c)
 				{
-					upper = std::upper_bound(begin(sums), end(sums), u);
+					const size_t offset = c * BLOCK_SIZE;
+					const size_t count = std::min(BLOCK_SIZE, N - offset);
+					size_t index = std::distance(begin(sums), std::upper_bound(begin(sums), end(sums), u + offset * step));
 
-					if(upper == end(sums))
+					for(size_t i = offset; i < offset + count; ++i)
 					{
-						std::advance(upper, -1);
-					}
+						const double pointer = u + i * step;
+
+						while(index < length && sums[index] <= pointer)
+						{
+							++index;
+						}
 
-					const auto offset = std::distance(begin(sums), upper);
-					*result++ = *(first + offset);
+						indices[i] = std::min(index, length - 1);
+					}
+				}
 
-					u += total / N;
-				});
+				std::copy(begin(indices), end(indices), result);
 			}
 
 		private:
-			template<typename InputIterator, typename Fitness, typename OutputIterator>
-			static double collect(InputIterator first, InputIterator last, Fitness fitness, OutputIterator result)
+			static constexpr size_t BLOCK_SIZE = 65536;
+
+			// inclusive prefix sums of the aligned fitness values, computed in two passes over
+			// fixed-size blocks so the result doesn't depend on the number of threads
+			static std::vector<double> accumulate(const fitness::FitnessTable &table)
 			{
-				return std::accumulate(first, last, 0.0, [&fitness, &result](const double min, auto &chromosome)
+				const size_t length = table.size();
+				const size_t blocks = (length + BLOCK_SIZE - 1) / BLOCK_SIZE;
+				double min = std::numeric_limits<double>::infinity();
+
+				#pragma omp parallel for reduction(min:min)
+				for(size_t i = 0; i < length; ++i)
 				{
-					double f = fitness(begin(chromosome), end(chromosome));
+					min = std::min(min, table[i]);
+				}
 
-					*result++ = f;
+				const double alignment = std::abs(std::min(0.0, min)) * 2;
+				std::vector<double> sums(length);
+				std::vector<double> offsets(blocks + 1, 0.0);
 
-					return std::min(f, min);
-				});
-			}
+				#pragma omp parallel for
+				for(size_t b = 0; b < blocks; ++b)
+				{
+					double sum = 0.0;
 
-			template<typename Iterator>
-			static double accumulate(Iterator first, Iterator last, const double min)
-			{
-				const double alignment = std::abs(std::min(0.0, min)) * 2;
+					for(size_t i = b * BLOCK_SIZE; i < std::min(length, (b + 1) * BLOCK_SIZE); ++i)
+					{
+						sum += table[i] + alignment;
+					}
+
+					offsets[b + 1] = sum;
+				}
+
+				std::partial_sum(begin(offsets), end(offsets), begin(offsets));
 
-				if(std::fetestexcept(FE_OVERFLOW))
+				if(!std::isfinite(offsets.back()))
 				{
 					throw std::overflow_error("Arithmetic overflow.");
 				}
 
-				double sum = 0.0;
-
-				while(first != last)
+				#pragma omp parallel for
+				for(size_t b = 0; b < blocks; ++b)
 				{
-					sum += *first + alignment;
+					double sum = offsets[b];
 
-					if(std::fetestexcept(FE_OVERFLOW))
+					for(size_t i = b * BLOCK_SIZE; i < std::min(length, (b + 1) * BLOCK_SIZE); ++i)
 					{
-						throw std::overflow_error("Arithmetic overflow.");
+						sum += table[i] + alignment;
+						sums[i] = sum;
 					}
-
-					*first++ = sum;
 				}
 
-				return sum;
+				return sums;
 			}
 	};
 }
@@ -25,8 +25,18 @@
 #include <algorithm>
 #include <vector>
 #include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <future>
+#include <iterator>
+#include <utility>
 
 #include "Random.hpp"
+#include "Fitness.hpp"
+#include "AsyncFitness.hpp"
+#include "Utils.hpp"
 
 namespace ea::stream
 {
@@ -59,12 +69,28 @@ namespace ea::stream
 			   @param first first individual of a population
 			   @param last points to the past-the-end element in the sequence
 
-			   Creates a new Stream.
+			   Creates a new Stream with a random seed.
 			 */
 			Stream(InputIterator first, InputIterator last)
+				: Stream(first, last, random::default_engine()())
+			{}
+
+			/**
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param seed seed of the stream
+
+			   Creates a new Stream. Each operation draws its random numbers from sub-streams
+			   derived from \p seed, the number of applied operations & the index of the
+			   processed individual. Streams with equal seeds produce equal results,
+			   independent of the number of threads.
+			 */
+			Stream(InputIterator first, InputIterator last, const uint64_t seed)
 				: index(0)
 				, first(first)
 				, last(last)
+				, seed(seed)
+				, generation(0)
 			{
 				std::copy(first, last, std::back_inserter(*state));
 			}
@@ -72,28 +98,127 @@ namespace ea::stream
 			/**
 			   @tparam Operator selection operator
 			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
 			   @param op selection operator
 			   @param count number of individuals to select from the stream
 			   @param fitness a fitness function
 			   @returns new Stream object
 
-			   Applies the given selection operator to the stream.
+			   Applies the given selection operator to the stream. If the operator provides
+			   select_indices() the selected individuals are moved instead of copied and
+			   their known fitness values are carried forward.
+
+			   Fitness values stored by evaluate(), mutate() or crossover() are reused
+			   if the operator accepts a FitnessTable (see fitness::accepts_fitness_table_v):
+			   \p fitness only evaluates individuals with unknown fitness. Call select() with the fitness function
+			   the values were computed with.
 			 */
 			template<typename Operator, typename Fitness>
 			Stream select(Operator op, const size_t count, Fitness fitness)
 			{
 				Stream stream = dup();
 				const int dst = !stream.index;
+				random::RandomEngine eng(stream.next_seed());
 
 				stream.state[dst].clear();
+				stream.values[dst].clear();
+				stream.pending[dst].clear();
 
-				op(std::begin(stream.state[stream.index]),
-				   std::end(stream.state[stream.index]),
-				   count,
-				   fitness,
-				   std::back_inserter(stream.state[dst]));
+				using Iterator = decltype(std::begin(stream.state[stream.index]));
+				using IndexIterator = std::back_insert_iterator<std::vector<size_t>>;
 
-				stream.index = dst;
+				if constexpr(selects_indices_v<Operator, Iterator, Iterator, size_t, Fitness, IndexIterator>)
+				{
+					std::vector<size_t> indices;
+
+					indices.reserve(count);
+
+					if constexpr(fitness::accepts_fitness_table_v<Operator>)
+					{
+						if(!stream.values[stream.index].empty())
+						{
+							// reuse known fitness values:
+							stream.complete(fitness);
+
+							invoke_select_indices(op,
+							                      eng,
+							                      std::begin(stream.state[stream.index]),
+							                      std::end(stream.state[stream.index]),
+							                      count,
+							                      fitness::FitnessTable(stream.values[stream.index]),
+							                      std::back_inserter(indices));
+
+							stream.gather(indices);
+
+							return stream;
+						}
+					}
+
+					invoke_select_indices(op,
+					                      eng,
+					                      std::begin(stream.state[stream.index]),
+					                      std::end(stream.state[stream.index]),
+					                      count,
+					                      fitness,
+					                      std::back_inserter(indices));
+
+					stream.gather(indices);
+
+					return stream;
+				}
+				else
+				{
+					if constexpr(fitness::accepts_fitness_table_v<Operator>)
+					{
+						if(!stream.values[stream.index].empty())
+						{
+							// reuse known fitness values:
+							stream.complete(fitness);
+
+							invoke(op,
+							       eng,
+							       std::begin(stream.state[stream.index]),
+							       std::end(stream.state[stream.index]),
+							       count,
+							       fitness::FitnessTable(stream.values[stream.index]),
+							       std::back_inserter(stream.state[dst]));
+
+							stream.index = dst;
+
+							return stream;
+						}
+					}
+
+					invoke(op,
+					       eng,
+					       std::begin(stream.state[stream.index]),
+					       std::end(stream.state[stream.index]),
+					       count,
+					       fitness,
+					       std::back_inserter(stream.state[dst]));
+
+					stream.index = dst;
+
+					return stream;
+				}
+			}
+
+			/**
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @param fitness a fitness function
+			   @returns new Stream object
+
+			   Evaluates all individuals with unknown fitness & stores the values in the
+			   stream. Selection operators applied afterwards reuse them and mutations
+			   update them incrementally if supported by the fitness function.
+			 */
+			template<typename Fitness>
+			Stream evaluate(Fitness fitness)
+			{
+				Stream stream = dup();
+
+				stream.complete(fitness);
 
 				return stream;
 			}
@@ -104,12 +229,35 @@ namespace ea::stream
 			   @param probability mutation probability (0..1)
 			   @returns new Stream object
 
-			   Applies the given mutation operator to the stream.
+			   Applies the given mutation operator to the stream. The stored fitness of
+			   mutated individuals becomes unknown.
 
 			   Throws std::invalid_argument if probability is out of range (0.0 <= p <= 1.0).
 			 */
 			template<typename Operator>
 			Stream mutate(Operator op, const double probability = 0.08)
+			{
+				return mutate(op, probability, NoFitness());
+			}
+
+			/**
+			   @tparam Operator mutation operator
+			   @tparam Fitness fitness function object providing a delta function (see fitness::has_delta_v)
+			   @param op mutation operator
+			   @param probability mutation probability (0..1)
+			   @param fitness a fitness function
+			   @returns new Stream object
+
+			   Applies the given mutation operator to the stream. If the operator reports
+			   the genes it changes, the stored fitness of mutated individuals is updated
+			   incrementally with the delta function of \p fitness. If \p fitness is an
+			   asynchronous evaluator (see fitness::Async), mutated individuals are submitted
+			   for evaluation as soon as they are created.
+
+			   Throws std::invalid_argument if probability is out of range (0.0 <= p <= 1.0).
+			 */
+			template<typename Operator, typename Fitness>
+			Stream mutate(Operator op, const double probability, Fitness fitness)
 			{
 				if(probability <= 0.0 || probability >= 1.0)
 				{
@@ -118,32 +266,79 @@ namespace ea::stream
 
 				Stream stream = dup();
 				const int dst = !stream.index;
-
-				stream.state[dst].clear();
+				const uint64_t seed = stream.next_seed();
 
 				const auto length = std::distance(std::begin(stream.state[index]), std::end(stream.state[index]));
+				std::vector<double> numbers;
+				random::RandomEngine eng(seed);
+
+				random::fill_n_real(std::back_inserter(numbers), length, 0.0, 1.0, eng);
+				stream.state[dst].resize(length);
+				stream.values[dst] = stream.values[index];
+				stream.pending[dst] = stream.pending[index];
 
-				#pragma omp parallel
+				if constexpr(fitness::is_async_v<Fitness>)
 				{
-					random::RandomEngine eng = random::default_engine();
-					std::uniform_real_distribution<double> dist(0.0, 1.0);
-					std::vector<typename InputIterator::value_type> mutants;
+					stream.track(dst);
+				}
+
+				using Chromosome = typename InputIterator::value_type;
+				using ChromosomeIterator = decltype(std::begin(std::declval<Chromosome &>()));
+				using Changes = std::vector<fitness::Change<typename std::iterator_traits<ChromosomeIterator>::value_type>>;
 
-					#pragma omp for
-					for(typename std::remove_const<decltype(length)>::type i = 0; i < length - 1; ++i)
+				constexpr bool incremental = fitness::has_delta_v<Fitness, ChromosomeIterator>
+				                             && std::is_invocable_v<Operator &,
+				                                                    ChromosomeIterator,
+				                                                    ChromosomeIterator,
+				                                                    random::RandomEngine &,
+				                                                    std::back_insert_iterator<Changes>>;
+
+				#pragma omp parallel for
+				for(typename std::remove_const<decltype(length)>::type i = 0; i < length; ++i)
+				{
+					auto &mutant = stream.state[dst][i];
+
+					mutant = stream.state[index][i];
+
+					if(numbers[i] <= probability)
 					{
-						auto mutant = stream.state[index][i];
+						random::RandomEngine mutant_eng(random::derive_seed(seed, i));
+
+						if constexpr(incremental)
+						{
+							if(!stream.pending[dst].empty() && stream.pending[dst][i].valid())
+							{
+								stream.values[dst][i] = stream.pending[dst][i].get();
+								stream.pending[dst][i] = std::shared_future<double>();
+							}
+
+							if(!stream.values[dst].empty() && !std::isnan(stream.values[dst][i]))
+							{
+								Changes changes;
 
-						if(dist(eng) <= probability)
+								op(std::begin(mutant), std::end(mutant), mutant_eng, std::back_inserter(changes));
+								stream.values[dst][i] = fitness.delta(std::begin(mutant), std::end(mutant), changes, stream.values[dst][i]);
+
+								continue;
+							}
+						}
+
+						invoke(op, mutant_eng, std::begin(mutant), std::end(mutant));
+
+						if(!stream.values[dst].empty())
 						{
-							op(std::begin(mutant), std::end(mutant));
+							stream.values[dst][i] = std::numeric_limits<double>::quiet_NaN();
 						}
 
-						mutants.push_back(mutant);
+						if constexpr(fitness::is_async_v<Fitness>)
+						{
+							stream.pending[dst][i] = fitness.submit(mutant);
+						}
+						else if(!stream.pending[dst].empty())
+						{
+							stream.pending[dst][i] = std::shared_future<double>();
+						}
 					}
-
-					#pragma omp critical
-					std::move(std::begin(mutants), std::end(mutants), std::back_inserter(stream.state[dst]));
 				}
 
 				stream.index = dst;
@@ -160,37 +355,88 @@ namespace ea::stream
 			 */
 			template<typename Operator>
 			Stream crossover(Operator op)
+			{
+				return crossover(op, NoFitness());
+			}
+
+			/**
+			   @tparam Operator crossover operator
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @param op crossover operator
+			   @param fitness a fitness function
+			   @returns new Stream object
+
+			   Applies the given crossover operator to the stream & evaluates the offspring.
+			   If \p fitness is an asynchronous evaluator (see fitness::Async), each offspring
+			   is submitted for evaluation as soon as the operator emits it and the stream
+			   waits for the result only when the fitness value is needed.
+			 */
+			template<typename Operator, typename Fitness>
+			Stream crossover(Operator op, Fitness fitness)
 			{
 				Stream stream = dup();
 				const int dst = !stream.index;
+				const uint64_t seed = stream.next_seed();
 
 				stream.state[dst].clear();
+				stream.values[dst].clear();
+				stream.pending[dst].clear();
 
 				const auto length = std::distance(std::begin(stream.state[index]), std::end(stream.state[index]));
 
-				#pragma omp parallel
+				// offsprings are collected per parent to keep the order independent of thread scheduling:
+				std::vector<std::vector<typename InputIterator::value_type>> offsprings(std::max<decltype(length)>(length, 1) - 1);
+				std::vector<std::vector<std::shared_future<double>>> futures(offsprings.size());
+
+				#pragma omp parallel for schedule(dynamic)
+				for(typename std::remove_const<decltype(length)>::type i = 0; i < length - 1; ++i)
 				{
-					std::vector<typename InputIterator::value_type> offsprings;
+					random::RandomEngine eng(random::derive_seed(seed, i));
 
-					#pragma omp for
-					for(typename std::remove_const<decltype(length)>::type i = 0; i < length - 1; ++i)
+					for(auto j = i + 1; j < length; ++j)
 					{
-						for(auto j = i + 1; j < length; ++j)
+						invoke(op,
+						       eng,
+						       std::begin(stream.state[index][i]),
+						       std::end(stream.state[index][i]),
+						       std::begin(stream.state[index][j]),
+						       std::end(stream.state[index][j]),
+						       std::back_inserter(offsprings[i]));
+
+						if constexpr(fitness::is_async_v<Fitness>)
 						{
-							op(std::begin(stream.state[index][i]),
-							   std::end(stream.state[index][i]),
-							   std::begin(stream.state[index][j]),
-							   std::end(stream.state[index][j]),
-							   std::back_inserter(offsprings));
+							while(futures[i].size() < offsprings[i].size())
+							{
+								futures[i].push_back(fitness.submit(offsprings[i][futures[i].size()]));
+							}
 						}
 					}
+				}
 
-					#pragma omp critical
-					std::move(std::begin(offsprings), std::end(offsprings), std::back_inserter(stream.state[dst]));
+				for(auto &o : offsprings)
+				{
+					std::move(std::begin(o), std::end(o), std::back_inserter(stream.state[dst]));
 				}
 
 				stream.index = dst;
 
+				if constexpr(fitness::is_async_v<Fitness>)
+				{
+					stream.track(dst);
+
+					auto pending = std::begin(stream.pending[dst]);
+
+					for(auto &f : futures)
+					{
+						pending = std::move(std::begin(f), std::end(f), pending);
+					}
+				}
+				else if constexpr(!std::is_same_v<Fitness, NoFitness>)
+				{
+					stream.complete(fitness);
+				}
+
 				return stream;
 			}
 
@@ -226,11 +472,193 @@ namespace ea::stream
 				return std::end(state[index]);
 			}
 
+			/**
+			   @return stored fitness values, NaN if unknown
+
+			   Returns the fitness values stored by evaluate() & carried forward by
+			   incremental mutations in the order of the stream's individuals.
+			 */
+			std::vector<double> fitness_values() const
+			{
+				if(values[index].empty())
+				{
+					return std::vector<double>(state[index].size(), std::numeric_limits<double>::quiet_NaN());
+				}
+
+				std::vector<double> known = values[index];
+
+				for(size_t i = 0; i < pending[index].size(); ++i)
+				{
+					if(pending[index][i].valid())
+					{
+						known[i] = pending[index][i].get();
+					}
+				}
+
+				return known;
+			}
+
 		private:
 			int index;
 			InputIterator first;
 			InputIterator last;
+			uint64_t seed;
+			uint64_t generation;
 			std::vector<typename InputIterator::value_type> state[2];
+			std::vector<double> values[2]; // empty if all fitness values are unknown
+			std::vector<std::shared_future<double>> pending[2]; // running evaluations, empty if there are none
+
+			struct NoFitness {};
+
+			uint64_t next_seed()
+			{
+				return random::derive_seed(seed, generation++);
+			}
+
+			template<typename Operator, typename = void, typename... Args>
+			struct selects_indices : std::false_type {};
+
+			template<typename Operator, typename... Args>
+			struct selects_indices<Operator,
+			                       std::void_t<decltype(std::declval<Operator &>().select_indices(std::declval<Args>()...))>,
+			                       Args...> : std::true_type {};
+
+			template<typename Operator, typename... Args>
+			static constexpr bool selects_indices_v = selects_indices<Operator, void, Args...>::value
+			                                          || selects_indices<Operator, void, Args..., random::RandomEngine &>::value;
+
+			// prepares fitness values of a buffer to receive running evaluations:
+			void track(const int i)
+			{
+				if(values[i].empty())
+				{
+					values[i].assign(state[i].size(), std::numeric_limits<double>::quiet_NaN());
+				}
+
+				pending[i].resize(state[i].size());
+			}
+
+			// waits for running evaluations:
+			void resolve()
+			{
+				for(size_t i = 0; i < pending[index].size(); ++i)
+				{
+					if(pending[index][i].valid())
+					{
+						values[index][i] = pending[index][i].get();
+					}
+				}
+
+				pending[index].clear();
+			}
+
+			template<typename Fitness>
+			void complete(Fitness fitness)
+			{
+				resolve();
+
+				auto &population = state[index];
+				auto &known = values[index];
+
+				if(known.empty())
+				{
+					const fitness::FitnessTable table(std::begin(population), std::end(population), fitness);
+
+					known.assign(table.begin(), table.end());
+				}
+				else if constexpr(fitness::is_batch_fitness_v<Fitness, decltype(std::begin(population))>)
+				{
+					// evaluate the individuals with unknown fitness in full batches:
+					std::vector<size_t> unknown;
+
+					for(size_t i = 0; i < known.size(); ++i)
+					{
+						if(std::isnan(known[i]))
+						{
+							unknown.push_back(i);
+						}
+					}
+
+					if(unknown.empty())
+					{
+						return;
+					}
+
+					std::vector<typename InputIterator::value_type> batch;
+
+					batch.reserve(unknown.size());
+					utils::gather(std::begin(population), std::begin(unknown), std::end(unknown), std::back_inserter(batch));
+
+					const fitness::FitnessTable table(std::begin(batch), std::end(batch), fitness);
+
+					for(size_t i = 0; i < unknown.size(); ++i)
+					{
+						known[unknown[i]] = table[i];
+					}
+				}
+				else
+				{
+					const auto length = std::distance(std::begin(population), std::end(population));
+
+					#pragma omp parallel for
+					for(typename std::remove_const<decltype(length)>::type i = 0; i < length; ++i)
+					{
+						if(std::isnan(known[i]))
+						{
+							auto &chromosome = *(std::begin(population) + i);
+
+							known[i] = fitness(std::begin(chromosome), std::end(chromosome));
+						}
+					}
+				}
+			}
+
+			template<typename Operator, typename... Args>
+			static void invoke(Operator &op, random::RandomEngine &eng, Args&&... args)
+			{
+				if constexpr(std::is_invocable_v<Operator&, Args..., random::RandomEngine&>)
+				{
+					op(std::forward<Args>(args)..., eng);
+				}
+				else
+				{
+					op(std::forward<Args>(args)...);
+				}
+			}
+
+			template<typename Operator, typename... Args>
+			static void invoke_select_indices(Operator &op, random::RandomEngine &eng, Args&&... args)
+			{
+				if constexpr(selects_indices<Operator, void, Args..., random::RandomEngine &>::value)
+				{
+					op.select_indices(std::forward<Args>(args)..., eng);
+				}
+				else
+				{
+					op.select_indices(std::forward<Args>(args)...);
+				}
+			}
+
+			// moves the individuals at the given positions & their fitness values to the other buffer:
+			void gather(const std::vector<size_t> &indices)
+			{
+				const int dst = !index;
+
+				if(!values[index].empty())
+				{
+					utils::gather(std::begin(values[index]), std::begin(indices), std::end(indices), std::back_inserter(values[dst]));
+				}
+
+				if(!pending[index].empty())
+				{
+					utils::gather(std::begin(pending[index]), std::begin(indices), std::end(indices), std::back_inserter(pending[dst]));
+				}
+
+				// the stream owns its buffers (see dup()), so individuals can be moved:
+				utils::gather_move(std::begin(state[index]), std::begin(indices), std::end(indices), std::back_inserter(state[dst]));
+
+				index = dst;
+			}
 
 			template<StateType S = State>
 			typename std::enable_if<S == StateType::stateless, Stream>::type
@@ -275,6 +703,21 @@ namespace ea::stream
 		return Stream<InputIterator, StateType::stateful>(first, last);
 	}
 
+	/**
+	   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+	   @param first first individual of a population
+	   @param last points to the past-the-end element in the sequence
+	   @param seed seed of the stream
+	   @return new Stream
+
+	   Creates a new mutable & reproducible stream.
+	 */
+	template<typename InputIterator>
+	Stream<InputIterator, StateType::stateful> make_mutable(InputIterator first, InputIterator last, const uint64_t seed)
+	{
+		return Stream<InputIterator, StateType::stateful>(first, last, seed);
+	}
+
 	/**
 	   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
 	   @param first first individual of a population
@@ -288,6 +731,21 @@ namespace ea::stream
 	{
 		return Stream<InputIterator, StateType::stateless>(first, last);
 	}
+
+	/**
+	   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+	   @param first first individual of a population
+	   @param last points to the past-the-end element in the sequence
+	   @param seed seed of the stream
+	   @return new Stream
+
+	   Creates a new immutable & reproducible stream.
+	 */
+	template<typename InputIterator>
+	Stream<InputIterator, StateType::stateless> make_immutable(InputIterator first, InputIterator last, const uint64_t seed)
+	{
+		return Stream<InputIterator, StateType::stateless>(first, last, seed);
+	}
 }
 
 #endif
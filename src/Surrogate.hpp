@@ -0,0 +1,390 @@
+/***************************************************************************
+    begin........: October 2026
+    copyright....: Sebastian Fedrau
+    email........: sebastian.fedrau@gmail.com
+ ***************************************************************************/
+
+/***************************************************************************
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License v3 as published by
+    the Free Software Foundation.
+
+    This program is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License v3 for more details.
+ ***************************************************************************/
+/**
+   @file Surrogate.hpp
+   @brief Approximation of expensive fitness functions.
+   @author Sebastian Fedrau <sebastian.fedrau@gmail.com>
+ */
+#ifndef EA_SURROGATE_HPP
+#define EA_SURROGATE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Diversity.hpp"
+
+namespace ea::fitness
+{
+	/**
+	   @class HammingDistance
+	   @brief Distance between chromosomes with discrete genes.
+	 */
+	struct HammingDistance
+	{
+		/**
+		   @tparam InputIterator must meet the requirements of LegacyInputIterator
+		   @param first1 points to the first element of the first chromosome
+		   @param last1 points to the end of the first chromosome
+		   @param first2 points to the first element of the second chromosome
+		   @param last2 points to the end of the second chromosome
+		   @return number of differing genes
+		 */
+		template<typename InputIterator>
+		double operator()(InputIterator first1, InputIterator last1, InputIterator first2, InputIterator last2) const
+		{
+			return static_cast<double>(diversity::hamming_distance(first1, last1, first2, last2));
+		}
+	};
+
+	/**
+	   @class EuclideanDistance
+	   @brief Distance between chromosomes with real-valued genes.
+	 */
+	struct EuclideanDistance
+	{
+		/**
+		   @tparam InputIterator must meet the requirements of LegacyInputIterator
+		   @param first1 points to the first element of the first chromosome
+		   @param last1 points to the end of the first chromosome
+		   @param first2 points to the first element of the second chromosome
+		   @param last2 points to the end of the second chromosome
+		   @return euclidean distance
+
+		   Throws std::length_error if chromosome lengths differ.
+		 */
+		template<typename InputIterator>
+		double operator()(InputIterator first1, InputIterator last1, InputIterator first2, InputIterator last2) const
+		{
+			double sum = 0.0;
+
+			for(; first1 != last1 && first2 != last2; ++first1, ++first2)
+			{
+				const double d = static_cast<double>(*first1) - static_cast<double>(*first2);
+
+				sum += d * d;
+			}
+
+			if(first1 != last1 || first2 != last2)
+			{
+				throw std::length_error("Set lengths have to be equal.");
+			}
+
+			return std::sqrt(sum);
+		}
+	};
+
+	/**
+	   @tparam Chromosome chromosome type
+
+	   EuclideanDistance for floating-point genes, HammingDistance otherwise.
+	 */
+	template<typename Chromosome>
+	using DefaultDistance = std::conditional_t<std::is_floating_point_v<typename Chromosome::value_type>,
+	                                           EuclideanDistance,
+	                                           HammingDistance>;
+
+	/**
+	   @class Surrogate
+	   @tparam Chromosome chromosome type, must be constructible from an iterator range
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	   @tparam Compare function to compare fitness values
+	   @tparam Distance function object: double fun(InputIterator first1, InputIterator last1,
+	                                                InputIterator first2, InputIterator last2)
+	   @brief Screens chromosomes with a k-nearest-neighbor model & evaluates only the
+	          most promising ones with the wrapped fitness function.
+
+	   Surrogate is a batch fitness function. It predicts the fitness of each
+	   chromosome of a batch from the k nearest chromosomes evaluated before
+	   (inverse distance weighting). The chromosomes of a batch with the best
+	   predictions are passed to the fitness function, the remaining chromosomes
+	   keep their predicted values. Chromosomes found in the archive get their
+	   stored fitness.
+
+	   The number of true evaluations is a running quota: over all calls the given
+	   fraction of the screened chromosomes is evaluated, independent of the batch
+	   sizes. Only chromosomes of the same batch compete for evaluation, so
+	   FitnessTable & streams pass the whole population in a single call (see
+	   batch_size).
+
+	   Evaluated chromosomes are added to a bounded archive, the oldest entries are
+	   replaced first. Until the archive holds k chromosomes the chromosomes of a
+	   batch are evaluated to build the model.
+
+	   Copies of the functor share the archive.
+	 */
+	template<typename Chromosome, typename Fitness, typename Compare = std::greater<double>, typename Distance = DefaultDistance<Chromosome>>
+	class Surrogate
+	{
+		public:
+			/*! The whole population is passed to the surrogate at once (see batch_size_v). */
+			static constexpr size_t batch_size = std::numeric_limits<size_t>::max();
+
+			/**
+			   @param fn a fitness function
+			   @param ratio fraction of screened chromosomes evaluated by \p fn (0..1]
+			   @param k number of neighbors used for predictions
+			   @param capacity maximum number of archived chromosomes
+
+			   Throws std::invalid_argument if \p ratio is out of range or \p k or
+			   \p capacity is zero.
+			 */
+			explicit Surrogate(Fitness fn, const double ratio = 0.2, const size_t k = 5, const size_t capacity = 1000)
+				: fn(fn)
+				, ratio(ratio)
+				, k(k)
+				, capacity(capacity)
+				, state(std::make_shared<State>())
+			{
+				if(ratio <= 0.0 || ratio > 1.0)
+				{
+					throw std::invalid_argument("Ratio out of range.");
+				}
+
+				if(k == 0 || capacity == 0)
+				{
+					throw std::invalid_argument("Number of neighbors and capacity cannot be zero.");
+				}
+			}
+
+			/**
+			   @tparam PopulationIterator must meet the requirements of LegacyRandomAccessIterator
+			   @param first iterator pointing to the first chromosome of a population
+			   @param last iterator pointing to the end (element after the last element) of a population
+			   @param out destination of the fitness values
+
+			   Writes the true or predicted fitness of each chromosome in the range \p first
+			   to \p last to \p out.
+			 */
+			template<typename PopulationIterator>
+			void operator()(PopulationIterator first, PopulationIterator last, double *out) const
+			{
+				const size_t length = std::distance(first, last);
+				size_t offset = 0;
+
+				// build the model from the first chromosomes until the archive holds k of them:
+				for(; offset < length && size() < k; ++offset)
+				{
+					auto &chromosome = *(first + offset);
+
+					{
+						std::shared_lock<std::shared_mutex> lock(state->mutex);
+
+						if(predict(chromosome, out[offset]))
+						{
+							++state->predictions;
+
+							continue;
+						}
+					}
+
+					out[offset] = fn(std::begin(chromosome), std::end(chromosome));
+
+					std::unique_lock<std::shared_mutex> lock(state->mutex);
+
+					store(Chromosome(std::begin(chromosome), std::end(chromosome)), out[offset]);
+					++state->evaluations;
+				}
+
+				std::vector<size_t> candidates;
+
+				{
+					std::shared_lock<std::shared_mutex> lock(state->mutex);
+
+					for(size_t i = offset; i < length; ++i)
+					{
+						if(!predict(*(first + i), out[i]))
+						{
+							candidates.push_back(i);
+						}
+					}
+				}
+
+				size_t budget;
+
+				{
+					std::unique_lock<std::shared_mutex> lock(state->mutex);
+
+					// running quota over all calls:
+					state->screened += candidates.size();
+
+					const size_t quota = static_cast<size_t>(std::ceil(state->screened * ratio));
+
+					budget = std::min(candidates.size(), quota > state->selected ? quota - state->selected : 0);
+					state->selected += budget;
+				}
+
+				std::nth_element(begin(candidates), begin(candidates) + budget, end(candidates), [out](size_t a, size_t b)
+				{
+					return Compare()(out[a], out[b]) || (!Compare()(out[b], out[a]) && a < b);
+				});
+
+				for(size_t i = 0; i < budget; ++i)
+				{
+					auto &chromosome = *(first + candidates[i]);
+
+					out[candidates[i]] = fn(std::begin(chromosome), std::end(chromosome));
+				}
+
+				std::unique_lock<std::shared_mutex> lock(state->mutex);
+
+				for(size_t i = 0; i < budget; ++i)
+				{
+					auto &chromosome = *(first + candidates[i]);
+
+					store(Chromosome(std::begin(chromosome), std::end(chromosome)), out[candidates[i]]);
+				}
+
+				state->evaluations += budget;
+				state->predictions += length - offset - budget;
+			}
+
+			/**
+			   @return number of chromosomes evaluated by the wrapped fitness function
+			 */
+			size_t evaluations() const
+			{
+				return state->evaluations;
+			}
+
+			/**
+			   @return number of chromosomes which got a predicted or archived fitness
+			           value (saved evaluations)
+			 */
+			size_t predictions() const
+			{
+				return state->predictions;
+			}
+
+			/**
+			   @return number of archived chromosomes
+			 */
+			size_t size() const
+			{
+				std::shared_lock<std::shared_mutex> lock(state->mutex);
+
+				return state->genomes.size();
+			}
+
+		private:
+			struct State
+			{
+				std::shared_mutex mutex;
+				std::vector<Chromosome> genomes;
+				std::vector<double> values;
+				size_t next = 0; // oldest entry, replaced when the archive is full
+				size_t screened = 0; // predicted chromosomes competing for evaluation
+				size_t selected = 0; // screened chromosomes passed to the fitness function
+				std::atomic<size_t> evaluations = 0;
+				std::atomic<size_t> predictions = 0;
+			};
+
+			Fitness fn;
+			const double ratio;
+			const size_t k;
+			const size_t capacity;
+			std::shared_ptr<State> state;
+
+			// writes the predicted fitness to value, returns true if the chromosome is archived:
+			template<typename C>
+			bool predict(const C &chromosome, double &value) const
+			{
+				std::vector<std::pair<double, double>> neighbors; // distance & fitness
+
+				neighbors.reserve(state->genomes.size());
+
+				for(size_t i = 0; i < state->genomes.size(); ++i)
+				{
+					const auto &genome = state->genomes[i];
+					const double d = Distance()(std::cbegin(chromosome), std::cend(chromosome), std::cbegin(genome), std::cend(genome));
+
+					if(d == 0.0)
+					{
+						value = state->values[i];
+
+						return true;
+					}
+
+					neighbors.emplace_back(d, state->values[i]);
+				}
+
+				const size_t count = std::min(k, neighbors.size());
+
+				std::partial_sort(begin(neighbors), begin(neighbors) + count, end(neighbors));
+
+				double sum = 0.0;
+				double weights = 0.0;
+
+				for(size_t i = 0; i < count; ++i)
+				{
+					const double w = 1.0 / neighbors[i].first;
+
+					sum += w * neighbors[i].second;
+					weights += w;
+				}
+
+				value = count > 0 ? sum / weights : 0.0;
+
+				return false;
+			}
+
+			void store(Chromosome &&chromosome, const double value) const
+			{
+				if(state->genomes.size() < capacity)
+				{
+					state->genomes.push_back(std::move(chromosome));
+					state->values.push_back(value);
+				}
+				else
+				{
+					state->genomes[state->next] = std::move(chromosome);
+					state->values[state->next] = value;
+					state->next = (state->next + 1) % capacity;
+				}
+			}
+	};
+
+	/**
+	   @tparam Chromosome chromosome type, must be constructible from an iterator range
+	   @tparam Compare function to compare fitness values
+	   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+	   @param fn a fitness function
+	   @param ratio fraction of screened chromosomes evaluated by \p fn (0..1]
+	   @param k number of neighbors used for predictions
+	   @param capacity maximum number of archived chromosomes
+	   @return new function object
+
+	   Wraps a fitness function with a k-nearest-neighbor surrogate model.
+	 */
+	template<typename Chromosome, typename Compare = std::greater<double>, typename Fitness>
+	Surrogate<Chromosome, Fitness, Compare> make_surrogate(Fitness fn, const double ratio = 0.2, const size_t k = 5, const size_t capacity = 1000)
+	{
+		return Surrogate<Chromosome, Fitness, Compare>(fn, ratio, k, capacity);
+	}
+}
+
+#endif
@@ -22,15 +22,18 @@
 #ifndef EA_TOURNAMENT_SELECTION_HPP
 #define EA_TOURNAMENT_SELECTION_HPP
 
+#include <algorithm>
+#include <array>
 #include <iterator>
 #include <limits>
 #include <numeric>
 #include <vector>
 #include <stdexcept>
+#include <optional>
 
 #include "Random.hpp"
-#include "Utils.hpp"
 #include "Fitness.hpp"
+#include "Utils.hpp"
 
 namespace ea::selection
 {
@@ -39,11 +42,19 @@ namespace ea::selection
 	   @tparam Compare function to compare fitness values
 	   @brief Selects N random individuals from a population. Then the fitness of each
 	          chromosome is compared to Q random opponents. The fittest individual is chosen.
+
+	   The N tournaments run in parallel. Each one draws from a sub-stream derived from
+	   a single number of the given random engine, so the selected individuals don't
+	   depend on the number of threads. Fitness values are computed once per individual
+	   & shared between the tournaments.
 	 */
 	template<typename Compare = std::greater<double>>
 	class Tournament
 	{
 		public:
+			/*! Fitness values can be passed as fitness::FitnessTable (see fitness::accepts_fitness_table_v). */
+			static constexpr bool accepts_fitness_table = true;
+
 			/**
 			   @param Q number of random opponents each selected individual is compared to
 
@@ -74,6 +85,179 @@ namespace ea::selection
 			 */
 			template<typename InputIterator, typename Fitness, typename OutputIterator>
 			void operator()(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
+			{
+				select_indices(first, last, N, fitness, utils::make_gather_iterator(first, result));
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from a population and copies them to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, fitness, utils::make_gather_iterator(first, result), eng);
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from an evaluated population and copies them to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result) const
+			{
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result));
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from an evaluated population and copies them to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			void operator()(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result, Engine &eng) const
+			{
+				select_indices(first, last, N, table, utils::make_gather_iterator(first, result), eng);
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from a population and writes their indices to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
+			{
+				select_indices(first, last, N, fitness, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam Fitness fitness function object: double fun(InputIterator first, InputIterator last)
+			                   or batch function: void fun(InputIterator first, InputIterator last, double *out)
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param fitness a fitness function
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from a population and writes their indices to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size.
+			 */
+			template<typename InputIterator, typename Fitness, typename OutputIterator, typename Engine>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result, Engine &eng) const
+			{
+				if constexpr(fitness::is_batch_fitness_v<Fitness, InputIterator>)
+				{
+					select_indices(first, last, N, fitness::FitnessTable(first, last, fitness), result, eng);
+				}
+				else
+				{
+					constexpr bool bounded = fitness::has_bounded_v<Fitness, decltype(std::begin(*first))>;
+
+					select<bounded>(first, last, N, fitness::MemoizeFitnessByIndex<InputIterator, Fitness>(fitness, std::distance(first, last)), result, eng);
+				}
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+
+			   Selects \p N individuals from an evaluated population and writes their indices to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result) const
+			{
+				select_indices(first, last, N, table, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator, receives size_t indices
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first first individual of a population
+			   @param last points to the past-the-end element in the sequence
+			   @param table fitness values of the population
+			   @param N number of individuals to select from the population
+			   @param result beginning of the destination range
+			   @param eng random engine
+
+			   Selects \p N individuals from an evaluated population and writes their indices to \p result.
+
+			   Throws std::length_error if \p Q exceeds the population size or the table doesn't
+			   match the population size.
+			 */
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			void select_indices(InputIterator first, InputIterator last, const size_t N, const fitness::FitnessTable &table, OutputIterator result, Engine &eng) const
+			{
+				fitness::check_table_size(table, std::distance(first, last));
+
+				select<false>(first, last, N, [&table](InputIterator, const size_t index)
+				{
+					return table[index];
+				}, result, eng);
+			}
+
+		private:
+			// Bounded: opponents are evaluated with FitnessByIndex::bounded(), the
+			// evaluation may stop as soon as the opponent is known to lose
+			template<bool Bounded, typename InputIterator, typename FitnessByIndex, typename OutputIterator, typename Engine>
+			void select(InputIterator first, InputIterator last, const size_t N, FitnessByIndex fitness_by_index, OutputIterator result, Engine &eng) const
 			{
 				const difference_type<InputIterator> length = std::distance(first, last);
 
@@ -82,45 +266,92 @@ namespace ea::selection
 					throw std::length_error("Q exceeds population size.");
 				}
 
-				random::RandomEngine engine = random::default_engine();
-				std::uniform_int_distribution<difference_type<InputIterator>> index_dist(0, length - 1);
-
-				auto fitness_by_index = fitness::memoize_fitness_by_index<InputIterator>(fitness);
+				std::vector<difference_type<InputIterator>> winners(N);
+				const uint64_t seed = random::bits64(eng);
 
-				utils::repeat(N, [&]()
+				#pragma omp parallel
 				{
-					std::vector<difference_type<InputIterator>> opponents(Q);
+					std::vector<difference_type<InputIterator>> buffer;
 
-					random::fill_distinct_n_int(begin(opponents), Q, static_cast<difference_type<InputIterator>>(0), length - 1);
-					difference_type<InputIterator> index = index_dist(engine);
-
-					while(std::find(begin(opponents), end(opponents), index) != end(opponents))
+					#pragma omp for
+					for(size_t i = 0; i < N; ++i)
 					{
-						index = index_dist(engine);
+						// each tournament draws from its own sub-stream, results don't depend on the number of threads:
+						random::RandomEngine contest_eng(random::derive_seed(seed, i));
+						std::array<difference_type<InputIterator>, MAX_STACK_CONTESTANTS> stack;
+						difference_type<InputIterator> *contestants = stack.data();
+
+						if(Q + 1 > MAX_STACK_CONTESTANTS)
+						{
+							buffer.resize(Q + 1);
+							contestants = buffer.data();
+							random::fill_distinct_n_int(contestants, Q + 1, static_cast<difference_type<InputIterator>>(0), length - 1, contest_eng);
+						}
+						else
+						{
+							draw_distinct(contestants, Q + 1, length, contest_eng);
+						}
+
+						// the last contestant is compared to the Q opponents:
+						difference_type<InputIterator> index = contestants[Q];
+
+						for(size_t j = 0; j < Q; ++j)
+						{
+							index = compare_genotypes<Bounded>(first, index, contestants[j], fitness_by_index);
+						}
+
+						winners[i] = index;
 					}
+				}
 
-					*result++ = *(first + std::accumulate(begin(opponents), end(opponents), index, [&](auto index, auto i)
-					{
-						return compare_genotypes(first, index, i, fitness_by_index);
-					}));
-				});
+				for(const auto index : winners)
+				{
+					*result++ = static_cast<size_t>(index);
+				}
 			}
 
-		private:
 			template<typename InputIterator>
 			using difference_type = typename std::iterator_traits<InputIterator>::difference_type;
 
+			// contestants up to this number are drawn into a buffer on the stack:
+			static constexpr size_t MAX_STACK_CONTESTANTS = 16;
+
 			const size_t Q;
 
-			template<typename InputIterator, typename Fitness>
+			template<typename T, typename E>
+			static void draw_distinct(T *out, const size_t count, const T length, E &eng)
+			{
+				std::uniform_int_distribution<T> dist(0, length - 1);
+
+				for(size_t i = 0; i < count; ++i)
+				{
+					do
+					{
+						out[i] = dist(eng);
+					} while(std::find(out, out + i, out[i]) != out + i);
+				}
+			}
+
+			template<bool Bounded, typename InputIterator, typename Fitness>
 			static difference_type<InputIterator> compare_genotypes(InputIterator first,
 			                                                        const difference_type<InputIterator> a,
 			                                                        const difference_type<InputIterator> b,
-			                                                        Fitness fitness)
+			                                                        Fitness &fitness)
 			{
 				difference_type<InputIterator> index = b;
+				const double fa = fitness(first, a);
+
+				if constexpr(Bounded)
+				{
+					// an aborted evaluation means b is worse than a:
+					const std::optional<double> fb = fitness.bounded(first, b, fa);
 
-				if(Compare()(fitness(first, a), fitness(first, b)))
+					if(!fb || Compare()(fa, *fb))
+					{
+						index = a;
+					}
+				}
+				else if(Compare()(fa, fitness(first, b)))
 				{
 					index = a;
 				}
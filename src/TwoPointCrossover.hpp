@@ -61,25 +61,54 @@ namespace ea::crossover
 			                  InputIterator first2,
 			                  InputIterator last2,
 			                  OutputIterator result) const
+			{
+				return (*this)(first1, last1, first2, last2, result, random::thread_engine());
+			}
+
+			/**
+			   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+			   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+			   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+			   @param first1 points to the first element of the first chromosome
+			   @param last1 points to the end of the first chromosome
+			   @param first2 points to the first element of the second chromosome
+			   @param last2 points to the end of the second chromosome
+			   @param result beginning of the destination range
+			   @param eng random engine
+			   @return number of offsprings written to \p result
+
+			   Combines two parents and generates two offsprings.
+
+			   Throws std::length_error if the length of at least one chromosome is less
+			   than three.
+			*/
+			template<typename InputIterator, typename OutputIterator, typename Engine>
+			size_t operator()(InputIterator first1,
+			                  InputIterator last1,
+			                  InputIterator first2,
+			                  InputIterator last2,
+			                  OutputIterator result,
+			                  Engine &eng) const
 			{
 				const auto length1 = std::distance(first1, last1);
 				const auto length2 = std::distance(first2, last2);
 
-				append(first1, last1, length1, first2, last2, length2, result);
-				append(first2, last2, length2, first1, last1, length1, result);
+				append(first1, last1, length1, first2, last2, length2, result, eng);
+				append(first2, last2, length2, first1, last1, length1, result, eng);
 
 				return 2;
 			}
 
 		private:
-			template<typename InputIterator, typename Distance, typename OutputIterator>
+			template<typename InputIterator, typename Distance, typename OutputIterator, typename Engine>
 			static void append(InputIterator first1,
 			                   InputIterator last1,
 			                   const Distance length1,
 			                   InputIterator first2,
 			                   InputIterator last2,
 			                   const Distance length2,
-			                   OutputIterator result)
+			                   OutputIterator result,
+			                   Engine &eng)
 			{
 				const auto min = std::min(length1, length2);
 
@@ -88,7 +117,6 @@ namespace ea::crossover
 					throw std::length_error("Chromosome too short.");
 				}
 
-				random::RandomEngine eng = random::default_engine();
 				std::uniform_int_distribution<typename std::remove_const<decltype(min)>::type> dist1(0, min - 2);
 				const auto separator1 = dist1(eng);
 
@@ -61,6 +61,33 @@ namespace ea::crossover
 			InputIterator first2,
 			InputIterator last2,
 			OutputIterator result) const
+		{
+			return (*this)(first1, last1, first2, last2, result, random::thread_engine());
+		}
+
+		/**
+		   @tparam InputIterator must meet the requirements of LegacyRandomAccessIterator
+		   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+		   @tparam Engine must meet the requirements of UniformRandomBitGenerator
+		   @param first1 points to the first element of the first chromosome
+		   @param last1 points to the end of the first chromosome
+		   @param first2 points to the first element of the second chromosome
+		   @param last2 points to the end of the second chromosome
+		   @param result beginning of the destination range
+		   @param eng random engine
+		   @return number of offsprings written to \p result
+
+		   Combines two parents and generates two offsprings.
+
+		   Throws std::length_error if length of both chromosomes isn't the same.
+		*/
+		template<typename InputIterator, typename OutputIterator, typename Engine>
+		size_t operator()(InputIterator first1,
+			InputIterator last1,
+			InputIterator first2,
+			InputIterator last2,
+			OutputIterator result,
+			Engine &eng) const
 		{
 			const auto length = std::distance(first1, last1);
 
@@ -69,7 +96,6 @@ namespace ea::crossover
 				throw std::length_error("Chromosome lengths have to be equal.");
 			}
 
-			random::RandomEngine eng = random::default_engine();
 			std::uniform_int_distribution<int> dist(0, 1);
 
 			Chromosome offsprings[2] = { Chromosome(length), Chromosome(length) };
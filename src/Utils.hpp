@@ -22,7 +22,10 @@
 #ifndef EA_UTILS_HPP
 #define EA_UTILS_HPP
 
+#include <algorithm>
 #include <iterator>
+#include <utility>
+#include <vector>
 
 namespace ea::utils
 {
@@ -80,6 +83,147 @@ namespace ea::utils
 	{
 		return std::prev(it == first ? last : it);
 	}
+
+	/**
+	   @tparam RandomAccessIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam IndexIterator must meet the requirements of LegacyInputIterator
+	   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+	   @param first iterator pointing to the first element of a sequence
+	   @param indices_first iterator pointing to the first index
+	   @param indices_last iterator pointing to the end (element after the last element) of the indices
+	   @param result beginning of the destination range
+	   @return iterator to the element past the last element written
+
+	   Copies the elements at the given positions of a sequence to \p result.
+	 */
+	template<typename RandomAccessIterator, typename IndexIterator, typename OutputIterator>
+	OutputIterator gather(RandomAccessIterator first, IndexIterator indices_first, IndexIterator indices_last, OutputIterator result)
+	{
+		for(; indices_first != indices_last; ++indices_first, ++result)
+		{
+			*result = *(first + *indices_first);
+		}
+
+		return result;
+	}
+
+	/**
+	   @tparam RandomAccessIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam IndexIterator must meet the requirements of LegacyForwardIterator
+	   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+	   @param first iterator pointing to the first element of a sequence
+	   @param indices_first iterator pointing to the first index
+	   @param indices_last iterator pointing to the end (element after the last element) of the indices
+	   @param result beginning of the destination range
+	   @return iterator to the element past the last element written
+
+	   Like gather(), but the last occurrence of each index moves the element instead
+	   of copying it. Selected elements are left in a valid but unspecified state.
+	 */
+	template<typename RandomAccessIterator, typename IndexIterator, typename OutputIterator>
+	OutputIterator gather_move(RandomAccessIterator first, IndexIterator indices_first, IndexIterator indices_last, OutputIterator result)
+	{
+		if(indices_first == indices_last)
+		{
+			return result;
+		}
+
+		std::vector<size_t> remaining(static_cast<size_t>(*std::max_element(indices_first, indices_last)) + 1, 0);
+
+		for(auto index = indices_first; index != indices_last; ++index)
+		{
+			++remaining[*index];
+		}
+
+		for(; indices_first != indices_last; ++indices_first, ++result)
+		{
+			auto &element = *(first + *indices_first);
+
+			if(--remaining[*indices_first] == 0)
+			{
+				*result = std::move(element);
+			}
+			else
+			{
+				*result = element;
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	   @class GatherIterator
+	   @tparam RandomAccessIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+	   @brief An output iterator receiving indices. The element at each index of a
+	          sequence is copied to a destination range.
+
+	   Lets index-producing selection functions write individuals directly.
+	 */
+	template<typename RandomAccessIterator, typename OutputIterator>
+	class GatherIterator
+	{
+		public:
+			using iterator_category = std::output_iterator_tag;
+			using value_type = void;
+			using difference_type = void;
+			using pointer = void;
+			using reference = void;
+
+			/**
+			   @param first iterator pointing to the first element of a sequence
+			   @param result beginning of the destination range
+			 */
+			GatherIterator(RandomAccessIterator first, OutputIterator result)
+				: first(first)
+				, result(result)
+			{}
+
+			/**
+			   @param index position of the element to copy
+			   @return reference to the iterator
+			 */
+			GatherIterator &operator=(const size_t index)
+			{
+				*result = *(first + index);
+				++result;
+
+				return *this;
+			}
+
+			GatherIterator &operator*()
+			{
+				return *this;
+			}
+
+			GatherIterator &operator++()
+			{
+				return *this;
+			}
+
+			GatherIterator &operator++(int)
+			{
+				return *this;
+			}
+
+		private:
+			RandomAccessIterator first;
+			OutputIterator result;
+	};
+
+	/**
+	   @tparam RandomAccessIterator must meet the requirements of LegacyRandomAccessIterator
+	   @tparam OutputIterator must meet the requirements of LegacyOutputIterator
+	   @param first iterator pointing to the first element of a sequence
+	   @param result beginning of the destination range
+	   @return new GatherIterator
+	 */
+	template<typename RandomAccessIterator, typename OutputIterator>
+	GatherIterator<RandomAccessIterator, OutputIterator> make_gather_iterator(RandomAccessIterator first, OutputIterator result)
+	{
+		return GatherIterator<RandomAccessIterator, OutputIterator>(first, result);
+	}
 }
 
 #endif
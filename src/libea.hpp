@@ -35,6 +35,13 @@ namespace ea
 #include "Random.hpp"
 #include "Diversity.hpp"
 #include "Fitness.hpp"
+#include "Statistics.hpp"
+#include "Pareto.hpp"
+#include "AsyncFitness.hpp"
+#include "ProcessFitness.hpp"
+#include "Surrogate.hpp"
+#include "FitnessCache.hpp"
+#include "Init.hpp"
 #include "Utils.hpp"
 
 #include "BitStringMutation.hpp"
@@ -56,6 +63,7 @@ namespace ea
 #include "DoubleTournamentSelection.hpp"
 #include "FitnessProportionalSelection.hpp"
 #include "FittestSelection.hpp"
+#include "ParetoTournamentSelection.hpp"
 #include "StochasticUniversalSampling.hpp"
 #include "TournamentSelection.hpp"
 
@@ -0,0 +1,347 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <optional>
+#include <numeric>
+
+#include "libea.hpp"
+
+template<typename F>
+static void measure(const std::string &name, const size_t repeats, F fn)
+{
+	fn(); // warm-up
+
+	const auto start = std::chrono::steady_clock::now();
+
+	ea::utils::repeat(repeats, fn);
+
+	const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << std::left << std::setw(48) << name
+	          << std::right << std::setw(12) << std::fixed << std::setprecision(3)
+	          << elapsed.count() / repeats << " us" << std::endl;
+}
+
+static void fill_distinct_n_int()
+{
+	const std::pair<const char *, ea::random::DistinctSampling> algorithms[] =
+	{
+		{ "automatic", ea::random::DistinctSampling::automatic },
+		{ "rejection", ea::random::DistinctSampling::rejection },
+		{ "floyd", ea::random::DistinctSampling::floyd },
+		{ "shuffle", ea::random::DistinctSampling::shuffle }
+	};
+
+	const std::pair<size_t, int> sizes[] =
+	{
+		{ 3, 1000 },
+		{ 59, 59 },
+		{ 100, 1000000 },
+		{ 1000, 1000 },
+		{ 5000, 5000 }
+	};
+
+	std::vector<int> numbers;
+
+	for(auto [count, range] : sizes)
+	{
+		for(auto [name, algorithm] : algorithms)
+		{
+			if(algorithm == ea::random::DistinctSampling::rejection && count > 1000)
+			{
+				continue;
+			}
+
+			measure("fill_distinct_n_int " + std::to_string(count) + "/" + std::to_string(range) + " " + name, 100, [&]()
+			{
+				numbers.clear();
+				ea::random::fill_distinct_n_int(std::back_inserter(numbers),
+				                                count,
+				                                0,
+				                                range - 1,
+				                                ea::random::thread_engine(),
+				                                algorithm);
+			});
+		}
+	}
+}
+
+static void bulk_generation()
+{
+	const size_t count = 100000;
+	std::vector<double> numbers(count);
+	std::mt19937 mt(42);
+	ea::random::RandomEngine eng(42);
+
+	measure("uniform_real_distribution (mt19937) 100000", 100, [&]()
+	{
+		std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+		std::generate(begin(numbers), end(numbers), [&]() { return dist(mt); });
+	});
+
+	measure("fill_n_real 100000", 100, [&]()
+	{
+		ea::random::fill_n_real(begin(numbers), count, 0.0, 1.0, eng);
+	});
+
+	measure("normal_distribution (mt19937) 100000", 100, [&]()
+	{
+		std::normal_distribution<double> dist(0.0, 1.0);
+
+		std::generate(begin(numbers), end(numbers), [&]() { return dist(mt); });
+	});
+
+	measure("fill_n_normal 100000", 100, [&]()
+	{
+		ea::random::fill_n_normal(begin(numbers), count, 0.0, 1.0, eng);
+	});
+
+	std::vector<double> genes(count);
+
+	measure("Gaussian mutation 100000 genes", 100, [&]()
+	{
+		ea::mutation::Gaussian(0.0, 1.0, 0.1)(begin(genes), end(genes), eng);
+	});
+}
+
+static void sparse_mutation()
+{
+	std::cout << "sparse mutation (p = 1/L):" << std::endl;
+
+	const size_t count = 100000;
+	const double probability = 1.0 / count;
+	ea::random::RandomEngine eng(42);
+	std::vector<bool> bits(count);
+	std::vector<double> genes(count);
+
+	const std::pair<const char *, ea::random::BernoulliSampling> algorithms[] =
+	{
+		{ "sequential", ea::random::BernoulliSampling::sequential },
+		{ "skip", ea::random::BernoulliSampling::skip }
+	};
+
+	for(auto [name, sampling] : algorithms)
+	{
+		const ea::mutation::BitString bit_string(probability, sampling);
+		const ea::mutation::Gaussian gaussian(0.0, 1.0, probability, sampling);
+
+		measure(std::string("BitString (") + name + ") 100000 genes", 100, [&]()
+		{
+			bit_string(begin(bits), end(bits), eng);
+		});
+
+		measure(std::string("Gaussian (") + name + ") 100000 genes", 100, [&]()
+		{
+			gaussian(begin(genes), end(genes), eng);
+		});
+	}
+}
+
+static void initialization()
+{
+	std::cout << "initialization (30000 permutations of 59 genes):" << std::endl;
+
+	std::vector<std::vector<int>> population(30000, std::vector<int>(59));
+
+	measure("fill_distinct_n_int per individual", 10, [&]()
+	{
+		for(auto &chromosome : population)
+		{
+			ea::random::fill_distinct_n_int(begin(chromosome), 59, 0, 58);
+		}
+	});
+
+	measure("init::permutations", 10, [&]()
+	{
+		ea::init::permutations(begin(population), end(population));
+	});
+}
+
+static double sum_of_genes(std::vector<int>::iterator first, std::vector<int>::iterator last)
+{
+	return std::accumulate(first, last, 0.0);
+}
+
+struct BoundedSum
+{
+	double operator()(std::vector<int>::iterator first, std::vector<int>::iterator last) const
+	{
+		return sum_of_genes(first, last);
+	}
+
+	std::optional<double> bounded(std::vector<int>::iterator first, std::vector<int>::iterator last, const double cutoff) const
+	{
+		double sum = 0.0;
+
+		for(auto it = first; it != last; ++it)
+		{
+			if((sum += *it) > cutoff)
+			{
+				return std::nullopt;
+			}
+		}
+
+		return sum;
+	}
+};
+
+static void selection()
+{
+	std::cout << "selection (10000 individuals, 100 genes):" << std::endl;
+
+	std::vector<std::vector<int>> population(10000, std::vector<int>(100));
+	std::vector<std::vector<int>> selected;
+
+	ea::init::permutations(begin(population), end(population));
+
+	measure("Tournament (N = 1000)", 10, [&]()
+	{
+		selected.clear();
+		ea::selection::Tournament()(begin(population), end(population), 1000, sum_of_genes, std::back_inserter(selected));
+	});
+
+	measure("DoubleTournament (N = 1000)", 10, [&]()
+	{
+		selected.clear();
+		ea::selection::DoubleTournament()(begin(population), end(population), 1000, sum_of_genes, std::back_inserter(selected));
+	});
+
+	// permutations share the same sum, random genes let bounded evaluations abort:
+	std::vector<std::vector<int>> genes(10000);
+
+	for(auto &g : genes)
+	{
+		ea::random::fill_n_int(std::back_inserter(g), 100, 0, 100);
+	}
+
+	measure("Tournament (N = 1000, minimize)", 10, [&]()
+	{
+		selected.clear();
+		ea::selection::Tournament<std::less<double>>()(begin(genes), end(genes), 1000, sum_of_genes, std::back_inserter(selected));
+	});
+
+	measure("Tournament (N = 1000, minimize, bounded)", 10, [&]()
+	{
+		selected.clear();
+		ea::selection::Tournament<std::less<double>>()(begin(genes), end(genes), 1000, BoundedSum(), std::back_inserter(selected));
+	});
+
+	measure("Fittest (N = 100, minimize)", 10, [&]()
+	{
+		selected.clear();
+		ea::selection::Fittest<std::less<double>>()(begin(genes), end(genes), 100, sum_of_genes, std::back_inserter(selected));
+	});
+
+	measure("Fittest (N = 100, minimize, bounded)", 10, [&]()
+	{
+		selected.clear();
+		ea::selection::Fittest<std::less<double>>()(begin(genes), end(genes), 100, BoundedSum(), std::back_inserter(selected));
+	});
+
+	std::vector<double> values;
+
+	ea::random::fill_n_int(std::back_inserter(values), 1000000, 0, 1000000);
+
+	const ea::fitness::FitnessTable table(values);
+	std::vector<size_t> indices(values.size());
+	std::vector<size_t> fittest;
+
+	std::iota(begin(indices), end(indices), 0);
+
+	for(const size_t N : { 3, 1000 })
+	{
+		measure("Fittest (N = " + std::to_string(N) + " of 1000000, table)", 10, [&]()
+		{
+			fittest.clear();
+			ea::selection::Fittest<>()(begin(indices), end(indices), N, table, std::back_inserter(fittest));
+		});
+	}
+
+	measure("FitnessProportional (N = 1000000, table)", 10, [&]()
+	{
+		fittest.clear();
+		ea::selection::FitnessProportional()(begin(indices), end(indices), 1000000, table, std::back_inserter(fittest));
+	});
+
+	measure("Tournament (N = 1000000, Q = 3, table)", 10, [&]()
+	{
+		fittest.clear();
+		ea::selection::Tournament<>()(begin(indices), end(indices), 1000000, table, std::back_inserter(fittest));
+	});
+
+	measure("StochasticUniversalSampling (N = 1000000, table)", 10, [&]()
+	{
+		fittest.clear();
+		ea::selection::StochasticUniversalSampling()(begin(indices), end(indices), 1000000, table, std::back_inserter(fittest));
+	});
+
+	const ea::selection::AliasTable alias(table);
+
+	measure("FitnessProportional (N = 1000000, alias table)", 10, [&]()
+	{
+		fittest.clear();
+		ea::selection::FitnessProportional()(begin(indices), end(indices), 1000000, alias, std::back_inserter(fittest));
+	});
+}
+
+static void fitness_dispatch()
+{
+	std::cout << "fitness dispatch (100000 individuals, 16 genes):" << std::endl;
+
+	std::vector<std::vector<int>> population(100000, std::vector<int>(16));
+
+	ea::init::bitstrings(begin(population), end(population));
+
+	auto one_max = [](auto first, auto last)
+	{
+		return static_cast<double>(std::count(first, last, 1));
+	};
+
+	ea::fitness::FitnessFunction<std::vector<std::vector<int>>::iterator> erased = one_max;
+	volatile double sink = 0.0;
+
+	measure("mean (std::function)", 100, [&]()
+	{
+		sink = ea::fitness::mean(begin(population), end(population), erased);
+	});
+
+	measure("mean (lambda)", 100, [&]()
+	{
+		sink = ea::fitness::mean(begin(population), end(population), one_max);
+	});
+
+	(void)sink;
+}
+
+static void pareto()
+{
+	std::cout << "non-dominated sort (50000 individuals):" << std::endl;
+
+	for(const size_t m : { 2, 3, 5 })
+	{
+		std::vector<double> values;
+
+		ea::random::fill_n_int(std::back_inserter(values), 50000 * m, 0, 1000000);
+
+		const ea::pareto::ObjectiveTable table(values, m);
+
+		measure(std::to_string(m) + " objectives", 3, [&]()
+		{
+			ea::pareto::non_dominated_sort(table);
+		});
+	}
+}
+
+auto main() -> int
+{
+	fill_distinct_n_int();
+	bulk_generation();
+	sparse_mutation();
+	initialization();
+	selection();
+	fitness_dispatch();
+	pareto();
+}
@@ -11,6 +11,12 @@
 #include <functional>
 #include <limits>
 #include <cmath>
+#include <atomic>
+#include <optional>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using DefaultTestGenome = std::vector<int>;
 using DefaultTestPopulation = std::vector<DefaultTestGenome>;
@@ -21,6 +27,9 @@ class UtilsTest : public CPPUNIT_NS::TestFixture
 {
 	CPPUNIT_TEST_SUITE(UtilsTest);
 	CPPUNIT_TEST(repeat);
+	CPPUNIT_TEST(gather);
+	CPPUNIT_TEST(gather_move);
+	CPPUNIT_TEST(gather_iterator);
 	CPPUNIT_TEST_SUITE_END();
 
 	protected:
@@ -35,6 +44,40 @@ class UtilsTest : public CPPUNIT_NS::TestFixture
 
 			CPPUNIT_ASSERT_EQUAL(100, n);
 		}
+
+		void gather()
+		{
+			const std::vector<int> values = { 10, 11, 12, 13 };
+			const std::vector<size_t> indices = { 3, 0, 3, 1 };
+			std::vector<int> result;
+
+			ea::utils::gather(std::begin(values), std::begin(indices), std::end(indices), std::back_inserter(result));
+
+			CPPUNIT_ASSERT(result == std::vector<int>({ 13, 10, 13, 11 }));
+		}
+
+		void gather_move()
+		{
+			std::vector<std::vector<int>> values = { { 0 }, { 1, 1 }, { 2, 2, 2 } };
+			const std::vector<size_t> indices = { 2, 2, 0 };
+			std::vector<std::vector<int>> result;
+
+			ea::utils::gather_move(std::begin(values), std::begin(indices), std::end(indices), std::back_inserter(result));
+
+			CPPUNIT_ASSERT(result == std::vector<std::vector<int>>({ { 2, 2, 2 }, { 2, 2, 2 }, { 0 } }));
+			CPPUNIT_ASSERT(values[1] == std::vector<int>({ 1, 1 }));
+		}
+
+		void gather_iterator()
+		{
+			const std::vector<int> values = { 10, 11, 12, 13 };
+			const std::vector<size_t> indices = { 2, 1, 1 };
+			std::vector<int> result;
+
+			std::copy(std::begin(indices), std::end(indices), ea::utils::make_gather_iterator(std::begin(values), std::back_inserter(result)));
+
+			CPPUNIT_ASSERT(result == std::vector<int>({ 12, 11, 11 }));
+		}
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(UtilsTest);
@@ -53,6 +96,14 @@ class RandomTest : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST(fill_distinct_n_int_difference);
 	CPPUNIT_TEST(fill_distinct_n_int_uniqueness);
 	CPPUNIT_TEST(fill_distinct_n_int_invalid_range_args);
+	CPPUNIT_TEST(fill_distinct_n_int_sampling);
+	CPPUNIT_TEST(thread_engine);
+	CPPUNIT_TEST(fill_with_engine);
+	CPPUNIT_TEST(xoshiro);
+	CPPUNIT_TEST(derive_seed);
+	CPPUNIT_TEST(fill_n_real_range);
+	CPPUNIT_TEST(fill_n_normal);
+	CPPUNIT_TEST(bernoulli_trials);
 	CPPUNIT_TEST_SUITE_END();
 
 	protected:
@@ -184,6 +235,163 @@ class RandomTest : public CPPUNIT_NS::TestFixture
 			CPPUNIT_ASSERT_THROW(ea::random::fill_distinct_n_int(std::back_inserter(numbers), 100, -99, -1), std::invalid_argument);
 		}
 
+		void fill_distinct_n_int_sampling()
+		{
+			const ea::random::DistinctSampling algorithms[] =
+			{
+				ea::random::DistinctSampling::automatic,
+				ea::random::DistinctSampling::rejection,
+				ea::random::DistinctSampling::floyd,
+				ea::random::DistinctSampling::shuffle
+			};
+
+			for(auto algorithm : algorithms)
+			{
+				for(int count : { 1, 3, 100, MAX_DISTINCT_NUMBERS })
+				{
+					std::vector<int> numbers;
+
+					ea::random::fill_distinct_n_int(std::back_inserter(numbers),
+					                                count,
+					                                -MAX_DISTINCT_NUMBERS,
+					                                MAX_DISTINCT_NUMBERS,
+					                                ea::random::thread_engine(),
+					                                algorithm);
+
+					CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(count), numbers.size());
+
+					std::sort(begin(numbers), end(numbers));
+
+					CPPUNIT_ASSERT(std::adjacent_find(begin(numbers), end(numbers)) == end(numbers));
+					CPPUNIT_ASSERT(numbers.front() >= -MAX_DISTINCT_NUMBERS && numbers.back() <= MAX_DISTINCT_NUMBERS);
+				}
+			}
+		}
+
+		void thread_engine()
+		{
+			CPPUNIT_ASSERT(&ea::random::thread_engine() == &ea::random::thread_engine());
+		}
+
+		void fill_with_engine()
+		{
+			ea::random::RandomEngine eng1(42);
+			ea::random::RandomEngine eng2(42);
+
+			std::vector<int> a;
+			std::vector<int> b;
+
+			ea::random::fill_n_int(std::back_inserter(a), MAX_NUMBERS, -100, 100, eng1);
+			ea::random::fill_n_int(std::back_inserter(b), MAX_NUMBERS, -100, 100, eng2);
+
+			CPPUNIT_ASSERT(a == b);
+
+			a.clear();
+			b.clear();
+
+			ea::random::fill_distinct_n_int(std::back_inserter(a), MAX_DISTINCT_NUMBERS, 1, MAX_DISTINCT_NUMBERS, eng1);
+			ea::random::fill_distinct_n_int(std::back_inserter(b), MAX_DISTINCT_NUMBERS, 1, MAX_DISTINCT_NUMBERS, eng2);
+
+			CPPUNIT_ASSERT(a == b);
+		}
+
+		void xoshiro()
+		{
+			ea::random::Xoshiro256 eng(1);
+
+			CPPUNIT_ASSERT(eng() == 0xb3f2af6d0fc710c5);
+			CPPUNIT_ASSERT(eng() == 0x853b559647364cea);
+			CPPUNIT_ASSERT(eng() == 0x92f89756082a4514);
+
+			eng.jump();
+
+			CPPUNIT_ASSERT(eng() == 0x4e6d496401657f6d);
+
+			ea::random::Xoshiro256 a(42);
+			ea::random::Xoshiro256 b(42);
+
+			b.long_jump();
+
+			CPPUNIT_ASSERT(a != b);
+		}
+
+		void derive_seed()
+		{
+			CPPUNIT_ASSERT(ea::random::derive_seed(1, 2, 3) == ea::random::derive_seed(1, 2, 3));
+			CPPUNIT_ASSERT(ea::random::derive_seed(1, 2, 3) == ea::random::derive_seed(ea::random::derive_seed(1, 2), 3));
+			CPPUNIT_ASSERT(ea::random::derive_seed(1, 2, 3) != ea::random::derive_seed(1, 3, 2));
+			CPPUNIT_ASSERT(ea::random::derive_seed(1, 2) != ea::random::derive_seed(2, 2));
+		}
+
+		void fill_n_real_range()
+		{
+			std::vector<double> numbers;
+
+			ea::random::fill_n_real(std::back_inserter(numbers), MAX_NUMBERS, -1.0, 1.0);
+
+			CPPUNIT_ASSERT_EQUAL(MAX_NUMBERS, numbers.size());
+
+			std::for_each(begin(numbers), end(numbers), [](const double n)
+			{
+				CPPUNIT_ASSERT(n >= -1.0 && n < 1.0);
+			});
+
+			const double mean = std::accumulate(begin(numbers), end(numbers), 0.0) / MAX_NUMBERS;
+
+			CPPUNIT_ASSERT(std::abs(mean) < 0.05);
+		}
+
+		void fill_n_normal()
+		{
+			std::vector<double> numbers;
+
+			ea::random::fill_n_normal(std::back_inserter(numbers), MAX_NUMBERS, 5.0, 2.0);
+
+			CPPUNIT_ASSERT_EQUAL(MAX_NUMBERS, numbers.size());
+
+			const double mean = std::accumulate(begin(numbers), end(numbers), 0.0) / MAX_NUMBERS;
+			const double variance = std::accumulate(begin(numbers), end(numbers), 0.0, [mean](double sum, double n)
+			{
+				return sum + (n - mean) * (n - mean);
+			}) / MAX_NUMBERS;
+
+			CPPUNIT_ASSERT(std::abs(mean - 5.0) < 0.05);
+			CPPUNIT_ASSERT(std::abs(variance - 4.0) < 0.2);
+		}
+
+		void bernoulli_trials()
+		{
+			for(auto sampling : {ea::random::BernoulliSampling::sequential, ea::random::BernoulliSampling::skip})
+			{
+				size_t successes = 0;
+				size_t previous = 0;
+				bool ascending = true;
+
+				ea::random::bernoulli_trials(MAX_NUMBERS, 0.01, [&](const size_t offset)
+				{
+					ascending = ascending && (successes == 0 || offset > previous) && offset < MAX_NUMBERS;
+					previous = offset;
+					++successes;
+				}, sampling);
+
+				CPPUNIT_ASSERT(ascending);
+				CPPUNIT_ASSERT(successes > 700 && successes < 950);
+
+				for(int i = 0; i < 100; ++i)
+				{
+					successes = 0;
+
+					ea::random::bernoulli_trials(10, 0.0001, [&](const size_t offset)
+					{
+						CPPUNIT_ASSERT(offset < 10);
+						++successes;
+					}, sampling, true);
+
+					CPPUNIT_ASSERT(successes >= 1);
+				}
+			}
+		}
+
 	private:
 		const size_t MAX_NUMBERS = 81920;
 		const int MAX_DISTINCT_NUMBERS = 2048;
@@ -198,6 +406,9 @@ class FitnessByIndexTest : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST_SUITE(FitnessByIndexTest);
 	CPPUNIT_TEST(fitness_by_index);
 	CPPUNIT_TEST(memoized_fitness_by_index);
+	CPPUNIT_TEST(memoized_fitness_by_index_sized);
+	CPPUNIT_TEST(memoized_fitness_by_index_shared);
+	CPPUNIT_TEST(memoized_fitness_by_index_mutable);
 	CPPUNIT_TEST_SUITE_END();
 
 	public:
@@ -232,6 +443,58 @@ class FitnessByIndexTest : public CPPUNIT_NS::TestFixture
 			compare_fitness_functions(ea::fitness::memoize_fitness_by_index<DefaultTestPopulation::iterator>(fitness));
 		}
 
+		void memoized_fitness_by_index_sized()
+		{
+			compare_fitness_functions(ea::fitness::memoize_fitness_by_index<DefaultTestPopulation::iterator>(fitness, POPULATION_SIZE));
+			compare_fitness_functions(ea::fitness::memoize_fitness_by_index<DefaultTestPopulation::iterator>(fitness, POPULATION_SIZE / 2));
+		}
+
+		void memoized_fitness_by_index_shared()
+		{
+			std::atomic<size_t> calls(0);
+
+			ea::fitness::MemoizeFitnessByIndex<DefaultTestPopulation::iterator> memo([&](auto first, auto last)
+			{
+				++calls;
+
+				return fitness(first, last);
+			}, POPULATION_SIZE);
+
+			for(int pass = 0; pass < 4; ++pass)
+			{
+				bool equal = true;
+
+				#pragma omp parallel for reduction(&&:equal)
+				for(size_t i = 0; i < POPULATION_SIZE; ++i)
+				{
+					auto &g = population[i];
+
+					equal = equal && memo(begin(population), i) == fitness(begin(g), end(g));
+				}
+
+				CPPUNIT_ASSERT(equal);
+			}
+
+			CPPUNIT_ASSERT_EQUAL(POPULATION_SIZE, calls.load());
+		}
+
+		void memoized_fitness_by_index_mutable()
+		{
+			size_t calls = 0;
+
+			auto memo = ea::fitness::memoize_fitness_by_index<DefaultTestPopulation::iterator>([&calls, n = size_t(0)](auto first, auto last) mutable
+			{
+				calls = ++n;
+
+				return fitness(first, last);
+			});
+
+			compare_fitness_functions(memo);
+			compare_fitness_functions(memo);
+
+			CPPUNIT_ASSERT_EQUAL(POPULATION_SIZE, calls);
+		}
+
 	private:
 		const size_t POPULATION_SIZE = 4096;
 		const size_t GENOME_SIZE = 64;
@@ -274,6 +537,10 @@ class FitnessUtilitiesTest : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST(median_empty);
 	CPPUNIT_TEST(fittest);
 	CPPUNIT_TEST(fittest_empty);
+	CPPUNIT_TEST(fitness_table);
+	CPPUNIT_TEST(batch);
+	CPPUNIT_TEST(summary);
+	CPPUNIT_TEST(summary_empty);
 	CPPUNIT_TEST_SUITE_END();
 
 	public:
@@ -380,151 +647,1265 @@ class FitnessUtilitiesTest : public CPPUNIT_NS::TestFixture
 			CPPUNIT_ASSERT(fitness == 0.0);
 		}
 
-	private:
-		template<typename Fn>
-		void test_empty_set_returns_nan(Fn fn)
+		void fitness_table()
 		{
 			DefaultTestPopulation population;
 
-			double value = fn(begin(population), end(population), std::distance<DefaultTestGenome::iterator>);
-
-			CPPUNIT_ASSERT(std::fpclassify(value) == FP_NAN);
-		}
-};
+			std::generate_n(std::back_inserter(population), 1001, [&]()
+			{
+				DefaultTestGenome g;
 
-CPPUNIT_TEST_SUITE_REGISTRATION(FitnessUtilitiesTest);
+				ea::random::fill_n_int(std::back_inserter(g), 10, 1, 100);
 
-template<typename Selection>
-static void select_children(Selection select, const size_t size = 1000, const size_t count = 100)
-{
-	DefaultTestPopulation population;
+				return g;
+			});
 
-	std::generate_n(std::back_inserter(population), size, [&]()
-	{
-		return DefaultTestGenome(10);
-	});
+			auto fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+			{
+				return static_cast<double>(std::accumulate(first, last, 0));
+			};
 
-	std::function<double(DefaultTestGenome::iterator, DefaultTestGenome::iterator)>
-	fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
-	{
-		return 0.0;
-	};
+			const ea::fitness::FitnessTable table(begin(population), end(population), fn);
 
-	DefaultTestPopulation children;
+			CPPUNIT_ASSERT_EQUAL(population.size(), table.size());
+			CPPUNIT_ASSERT(std::abs(ea::fitness::mean(table) - ea::fitness::mean(begin(population), end(population), fn)) < 1e-9);
+			CPPUNIT_ASSERT(ea::fitness::median(table) == ea::fitness::median(begin(population), end(population), fn));
+			CPPUNIT_ASSERT(ea::fitness::fittest(begin(population), end(population), table)
+			               == ea::fitness::fittest(begin(population), end(population), fn));
 
-	select(begin(population), end(population), 0, fn, std::back_inserter(children));
-	select(begin(population), end(population), count, fn, std::back_inserter(children));
+			CPPUNIT_ASSERT(std::fpclassify(ea::fitness::mean(ea::fitness::FitnessTable())) == FP_NAN);
+			CPPUNIT_ASSERT(std::fpclassify(ea::fitness::median(ea::fitness::FitnessTable())) == FP_NAN);
+		}
 
-	CPPUNIT_ASSERT(children.size() == count);
-}
+		void batch()
+		{
+			DefaultTestPopulation population;
 
-template<typename Compare = std::greater<double>, typename Selection>
-static void fitness_increases(Selection select, const size_t size = 10000, const size_t count = 1000)
-{
-	DefaultTestPopulation population;
+			std::generate_n(std::back_inserter(population), 1000, [&]()
+			{
+				DefaultTestGenome g;
 
-	std::generate_n(std::back_inserter(population), size, [&]()
-	{
-		DefaultTestGenome g;
+				ea::random::fill_n_int(std::back_inserter(g), 10, 1, 100);
 
-		ea::random::fill_n_int(std::back_inserter(g), 10, -100, 100);
+				return g;
+			});
 
-		return g;
-	});
+			auto fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+			{
+				return static_cast<double>(std::accumulate(first, last, 0));
+			};
 
-	std::function<double(DefaultTestGenome::iterator, DefaultTestGenome::iterator)>
-	fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
-	{
-		return static_cast<double>(std::accumulate(first, last, 0, [](int total, int n) { return total + n; }));
-	};
+			std::atomic<size_t> calls(0);
+			std::atomic<bool> bounded(true);
 
-	DefaultTestPopulation children;
+			auto batch = [&](DefaultTestPopulation::iterator first, DefaultTestPopulation::iterator last, double *out)
+			{
+				++calls;
+				bounded = bounded && std::distance(first, last) <= static_cast<std::ptrdiff_t>(ea::fitness::BATCH_SIZE);
+				ea::fitness::batch(fn)(first, last, out);
+			};
 
-	select(begin(population), end(population), count, fn, std::back_inserter(children));
+			static_assert(ea::fitness::is_batch_fitness_v<decltype(batch), DefaultTestPopulation::iterator>);
+			static_assert(!ea::fitness::is_batch_fitness_v<decltype(fn), DefaultTestPopulation::iterator>);
 
-	double a = ea::fitness::mean(begin(population), end(population), fn);
-	double b = ea::fitness::mean(begin(children), end(children), fn);
+			const ea::fitness::FitnessTable a(begin(population), end(population), fn);
+			const ea::fitness::FitnessTable b(begin(population), end(population), batch);
 
-	CPPUNIT_ASSERT(Compare()(b, a));
-}
+			CPPUNIT_ASSERT(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+			CPPUNIT_ASSERT_EQUAL((population.size() + ea::fitness::BATCH_SIZE - 1) / ea::fitness::BATCH_SIZE, calls.load());
+			CPPUNIT_ASSERT(bounded);
 
-template<typename Selection>
-static void is_subset(Selection select, const size_t size = 1000, const size_t count = 10)
-{
-	DefaultTestPopulation population;
+			CPPUNIT_ASSERT(ea::fitness::mean(begin(population), end(population), batch) == ea::fitness::mean(a));
+			CPPUNIT_ASSERT(ea::fitness::median(begin(population), end(population), batch) == ea::fitness::median(a));
+			CPPUNIT_ASSERT(ea::fitness::fittest(begin(population), end(population), batch)
+			               == ea::fitness::fittest(begin(population), end(population), fn));
 
-	std::generate_n(std::back_inserter(population), size, [&]()
-	{
-		DefaultTestGenome g;
+			// batch functions may choose their batch size:
+			std::vector<size_t> sizes;
+			const Whole whole = { &sizes };
+			const ea::fitness::FitnessTable c(begin(population), end(population), whole);
 
-		ea::random::fill_n_int(std::back_inserter(g), 10, 1, 100);
+			CPPUNIT_ASSERT(std::equal(a.begin(), a.end(), c.begin(), c.end()));
+			CPPUNIT_ASSERT(sizes == std::vector<size_t>({ population.size() }));
+			CPPUNIT_ASSERT_EQUAL(ea::fitness::BATCH_SIZE, ea::fitness::batch_size_v<decltype(batch)>);
 
-		return g;
-	});
+			// adapt a function object with a non-const call operator:
+			size_t evaluated = 0;
+			std::vector<double> d(population.size());
 
-	std::function<double(DefaultTestGenome::iterator, DefaultTestGenome::iterator)>
-	fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
-	{
-		return static_cast<double>(std::accumulate(first, last, 1, [](int factorial, int n) { return factorial * n; }));
-	};
+			ea::fitness::batch([&evaluated, n = size_t(0)](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last) mutable
+			{
+				evaluated = ++n;
 
-	DefaultTestPopulation children;
+				return static_cast<double>(std::accumulate(first, last, 0));
+			})(begin(population), end(population), d.data());
 
-	select(begin(population), end(population), count, fn, std::back_inserter(children));
+			CPPUNIT_ASSERT(std::equal(a.begin(), a.end(), d.begin(), d.end()));
+			CPPUNIT_ASSERT_EQUAL(population.size(), evaluated);
+		}
 
-	std::for_each(begin(children), end(children), [&population](auto a)
-	{
-		auto match = std::find_if(begin(population), end(population), [&a](auto b)
+	private:
+		// batch function receiving the whole population at once
+		struct Whole
 		{
-			bool equal = a.size() == b.size();
-			size_t i = 0;
+			static constexpr size_t batch_size = std::numeric_limits<size_t>::max();
 
-			while(equal && i < a.size())
+			std::vector<size_t> *sizes;
+
+			void operator()(DefaultTestPopulation::iterator first, DefaultTestPopulation::iterator last, double *out) const
 			{
-				equal = a[i] == b[i];
-				++i;
+				sizes->push_back(std::distance(first, last));
+
+				for(; first != last; ++first)
+				{
+					*out++ = static_cast<double>(std::accumulate(std::begin(*first), std::end(*first), 0));
+				}
 			}
+		};
 
-			return equal;
-		});
+		template<typename Fn>
+		void test_empty_set_returns_nan(Fn fn)
+		{
+			DefaultTestPopulation population;
 
-		CPPUNIT_ASSERT(match != end(population));
-	});
-}
+			double value = fn(begin(population), end(population), std::distance<DefaultTestGenome::iterator>);
 
-template<typename Error, typename Selection>
-void select_error(Selection op, size_t size = 0, size_t count = 0)
-{
-	DefaultTestPopulation population;
+			CPPUNIT_ASSERT(std::fpclassify(value) == FP_NAN);
+		}
 
-	std::generate_n(std::back_inserter(population), size, [&]()
-	{
-		DefaultTestGenome g;
+		void summary()
+		{
+			DefaultTestPopulation population;
 
-		ea::random::fill_n_int(std::back_inserter(g), 10, -100, 100);
+			std::generate_n(std::back_inserter(population), 10001, [&]()
+			{
+				DefaultTestGenome g;
 
-		return g;
-	});
+				ea::random::fill_n_int(std::back_inserter(g), 10, 1, 100);
 
-	DefaultTestPopulation children; 
+				return g;
+			});
 
-	std::function<double(DefaultTestGenome::iterator, DefaultTestGenome::iterator)>
-	fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
-	{
-		return 0;
-	};
+			auto fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+			{
+				return static_cast<double>(std::accumulate(first, last, 0));
+			};
 
-	CPPUNIT_ASSERT_THROW(op(begin(population), end(population), count, fn, std::back_inserter(children)), Error);
-}
+			const auto summary = ea::fitness::summary(begin(population), end(population), fn, { 1.0, 0.0, 0.25, 0.9 });
+			const ea::fitness::FitnessTable table(begin(population), end(population), fn);
+			std::vector<double> sorted(table.begin(), table.end());
 
-#include "TournamentSelection.hpp"
+			std::sort(begin(sorted), end(sorted));
 
-class TournamentSelectionTest : public CPPUNIT_NS::TestFixture
-{
-	CPPUNIT_TEST_SUITE(TournamentSelectionTest);
+			const double mean = ea::fitness::mean(table);
+			const double variance = std::accumulate(table.begin(), table.end(), 0.0, [mean](double sum, double v)
+			{
+				return sum + (v - mean) * (v - mean);
+			}) / table.size();
+
+			CPPUNIT_ASSERT_EQUAL(population.size(), summary.count);
+			CPPUNIT_ASSERT(std::abs(summary.mean - mean) < 1e-9);
+			CPPUNIT_ASSERT(std::abs(summary.variance - variance) < 1e-6);
+			CPPUNIT_ASSERT_EQUAL(ea::fitness::median(table), summary.median);
+			CPPUNIT_ASSERT_EQUAL(sorted.front(), summary.min);
+			CPPUNIT_ASSERT_EQUAL(sorted.back(), summary.max);
+			CPPUNIT_ASSERT(begin(population) + summary.argmax == std::get<0>(ea::fitness::fittest(begin(population), end(population), table)));
+			CPPUNIT_ASSERT(begin(population) + summary.argmin
+			               == std::get<0>(ea::fitness::fittest<DefaultTestPopulation::iterator, std::less<double>>(begin(population), end(population), table)));
+
+			CPPUNIT_ASSERT_EQUAL(size_t(4), summary.quantiles.size());
+			CPPUNIT_ASSERT_EQUAL(sorted.back(), summary.quantiles[0]);
+			CPPUNIT_ASSERT_EQUAL(sorted.front(), summary.quantiles[1]);
+			CPPUNIT_ASSERT_EQUAL(sorted[sorted.size() / 4], summary.quantiles[2]);
+			CPPUNIT_ASSERT_EQUAL(sorted[sorted.size() * 9 / 10], summary.quantiles[3]);
+
+			CPPUNIT_ASSERT_THROW(ea::fitness::summary(table, { 1.5 }), std::invalid_argument);
+
+			const ea::fitness::FitnessTable huge(std::vector<double>(4, std::numeric_limits<double>::max()));
+
+			CPPUNIT_ASSERT_THROW(ea::fitness::summary(huge), std::overflow_error);
+		}
+
+		void summary_empty()
+		{
+			const auto summary = ea::fitness::summary(ea::fitness::FitnessTable(), { 0.5 });
+
+			CPPUNIT_ASSERT_EQUAL(size_t(0), summary.count);
+			CPPUNIT_ASSERT(std::isnan(summary.mean));
+			CPPUNIT_ASSERT(std::isnan(summary.variance));
+			CPPUNIT_ASSERT(std::isnan(summary.median));
+			CPPUNIT_ASSERT(std::isnan(summary.min));
+			CPPUNIT_ASSERT(std::isnan(summary.max));
+			CPPUNIT_ASSERT(std::isnan(summary.quantiles[0]));
+		}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FitnessUtilitiesTest);
+
+#include <list>
+#include "Statistics.hpp"
+
+class StatisticsTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE(StatisticsTest);
+	CPPUNIT_TEST(moments);
+	CPPUNIT_TEST(quantiles);
+	CPPUNIT_TEST(merge);
+	CPPUNIT_TEST(accumulate);
+	CPPUNIT_TEST(invalid_args);
+	CPPUNIT_TEST_SUITE_END();
+
+	protected:
+		void moments()
+		{
+			ea::statistics::Moments moments;
+
+			CPPUNIT_ASSERT(moments.count() == 0);
+			CPPUNIT_ASSERT(std::isnan(moments.mean()));
+			CPPUNIT_ASSERT(std::isnan(moments.variance()));
+			CPPUNIT_ASSERT(std::isnan(moments.min()));
+
+			for(const double value : { 2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0 })
+			{
+				moments.add(value);
+			}
+
+			CPPUNIT_ASSERT(moments.count() == 8);
+			CPPUNIT_ASSERT(std::abs(moments.mean() - 5.0) < 1e-12);
+			CPPUNIT_ASSERT(std::abs(moments.variance() - 4.0) < 1e-12);
+			CPPUNIT_ASSERT(moments.min() == 2.0);
+			CPPUNIT_ASSERT(moments.max() == 9.0);
+		}
+
+		void quantiles()
+		{
+			ea::statistics::TDigest digest;
+
+			for(int i = 0; i < 100000; ++i)
+			{
+				digest.add((i * 7919) % 100000);
+			}
+
+			CPPUNIT_ASSERT(digest.count() == 100000);
+			CPPUNIT_ASSERT(digest.size() <= 200);
+			CPPUNIT_ASSERT(digest.quantile(0.0) == 0.0);
+			CPPUNIT_ASSERT(digest.quantile(1.0) == 99999.0);
+			CPPUNIT_ASSERT(std::abs(digest.quantile(0.5) - 50000.0) < 500.0);
+			CPPUNIT_ASSERT(std::abs(digest.quantile(0.1) - 10000.0) < 200.0);
+			CPPUNIT_ASSERT(std::abs(digest.quantile(0.99) - 99000.0) < 50.0);
+
+			ea::statistics::TDigest small;
+
+			for(const double value : { 3.0, 1.0, 2.0 })
+			{
+				small.add(value);
+			}
+
+			CPPUNIT_ASSERT(std::abs(small.quantile(0.5) - 2.0) < 1e-12);
+		}
+
+		void merge()
+		{
+			ea::statistics::Accumulator a;
+			ea::statistics::Accumulator b;
+			ea::statistics::Accumulator all;
+
+			for(int i = 0; i < 20000; ++i)
+			{
+				const double value = (i * 104729) % 20000 + 0.5;
+
+				(i % 3 == 0 ? a : b).add(value);
+				all.add(value);
+			}
+
+			a.merge(b);
+
+			CPPUNIT_ASSERT(a.count() == all.count());
+			CPPUNIT_ASSERT(std::abs(a.mean() - all.mean()) < 1e-9);
+			CPPUNIT_ASSERT(std::abs(a.variance() - all.variance()) < 1e-6);
+			CPPUNIT_ASSERT(a.min() == all.min());
+			CPPUNIT_ASSERT(a.max() == all.max());
+			CPPUNIT_ASSERT(std::abs(a.median() - all.median()) < 100.0);
+			CPPUNIT_ASSERT(std::abs(a.quantile(0.95) - all.quantile(0.95)) < 50.0);
+
+			ea::statistics::Accumulator empty;
+
+			a.merge(empty);
+
+			CPPUNIT_ASSERT(a.count() == all.count());
+		}
+
+		void accumulate()
+		{
+			std::vector<std::vector<int>> population;
+
+			for(int i = 0; i < 1000; ++i)
+			{
+				population.push_back({ i, 1 });
+			}
+
+			const std::list<std::vector<int>> list(std::begin(population), std::end(population));
+
+			auto fn = [](auto first, auto last)
+			{
+				return static_cast<double>(std::accumulate(first, last, 0));
+			};
+
+			auto parallel = ea::statistics::accumulate(std::begin(population), std::end(population), fn);
+			auto serial = ea::statistics::accumulate(std::begin(list), std::end(list), fn);
+			auto summary = ea::fitness::summary(std::begin(population), std::end(population), fn, { 0.25 });
+
+			for(auto *statistics : { &parallel, &serial })
+			{
+				CPPUNIT_ASSERT(statistics->count() == summary.count);
+				CPPUNIT_ASSERT(std::abs(statistics->mean() - summary.mean) < 1e-9);
+				CPPUNIT_ASSERT(std::abs(statistics->variance() - summary.variance) < 1e-6);
+				CPPUNIT_ASSERT(statistics->min() == summary.min);
+				CPPUNIT_ASSERT(statistics->max() == summary.max);
+				CPPUNIT_ASSERT(std::abs(statistics->median() - summary.median) < 5.0);
+				CPPUNIT_ASSERT(std::abs(statistics->quantile(0.25) - summary.quantiles[0]) < 5.0);
+			}
+
+			auto empty = ea::statistics::accumulate(std::begin(list), std::begin(list), fn);
+
+			CPPUNIT_ASSERT(empty.count() == 0);
+			CPPUNIT_ASSERT(std::isnan(empty.median()));
+		}
+
+		void invalid_args()
+		{
+			CPPUNIT_ASSERT_THROW(ea::statistics::TDigest(0.5), std::invalid_argument);
+
+			ea::statistics::Accumulator accumulator;
+
+			accumulator.add(1.0);
+
+			CPPUNIT_ASSERT_THROW(accumulator.quantile(1.5), std::invalid_argument);
+			CPPUNIT_ASSERT_THROW(accumulator.quantile(-0.1), std::invalid_argument);
+		}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StatisticsTest);
+
+#include "FitnessCache.hpp"
+
+class FitnessCacheTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE(FitnessCacheTest);
+	CPPUNIT_TEST(hits_and_misses);
+	CPPUNIT_TEST(capacity);
+	CPPUNIT_TEST(shared);
+	CPPUNIT_TEST(mutable_fitness);
+	CPPUNIT_TEST(invalid_args);
+	CPPUNIT_TEST_SUITE_END();
+
+	protected:
+		void hits_and_misses()
+		{
+			size_t calls = 0;
+
+			auto cache = ea::fitness::make_cache<DefaultTestGenome>([&calls](auto first, auto last)
+			{
+				++calls;
+
+				return static_cast<double>(std::accumulate(first, last, 0));
+			});
+
+			DefaultTestGenome a = { 1, 2, 3 };
+			DefaultTestGenome b = { 3, 2, 1 };
+
+			CPPUNIT_ASSERT_EQUAL(6.0, cache(begin(a), end(a)));
+			CPPUNIT_ASSERT_EQUAL(6.0, cache(begin(b), end(b)));
+			CPPUNIT_ASSERT_EQUAL(6.0, cache(begin(a), end(a)));
+
+			auto copy = cache;
+
+			CPPUNIT_ASSERT_EQUAL(6.0, copy(begin(b), end(b)));
+
+			CPPUNIT_ASSERT_EQUAL(size_t(2), calls);
+			CPPUNIT_ASSERT_EQUAL(size_t(2), cache.hits());
+			CPPUNIT_ASSERT_EQUAL(size_t(2), cache.misses());
+			CPPUNIT_ASSERT_EQUAL(size_t(2), cache.size());
+
+			cache.clear();
+
+			CPPUNIT_ASSERT_EQUAL(size_t(0), cache.size());
+			CPPUNIT_ASSERT_EQUAL(size_t(0), cache.hits());
+		}
+
+		void capacity()
+		{
+			auto cache = ea::fitness::make_cache<DefaultTestGenome>([](auto first, auto last)
+			{
+				return static_cast<double>(std::distance(first, last));
+			}, 100, 4);
+
+			for(int i = 0; i < 1000; ++i)
+			{
+				DefaultTestGenome g(i % 250);
+
+				CPPUNIT_ASSERT_EQUAL(static_cast<double>(g.size()), cache(begin(g), end(g)));
+			}
+
+			CPPUNIT_ASSERT(cache.size() <= 100);
+			CPPUNIT_ASSERT_EQUAL(size_t(1000), cache.hits() + cache.misses());
+
+			// a capacity which isn't a multiple of the number of shards is fully used:
+			auto sharded = ea::fitness::make_cache<DefaultTestGenome>([](auto first, auto)
+			{
+				return static_cast<double>(*first);
+			}, 100, 64);
+
+			for(int i = 0; i < 10000; ++i)
+			{
+				DefaultTestGenome g = { i };
+
+				sharded(begin(g), end(g));
+			}
+
+			CPPUNIT_ASSERT_EQUAL(size_t(100), sharded.size());
+		}
+
+		void shared()
+		{
+			DefaultTestPopulation population(1000);
+
+			for(size_t i = 0; i < population.size(); ++i)
+			{
+				ea::random::fill_n_int(std::back_inserter(population[i]), 10, 0, 100);
+			}
+
+			auto fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+			{
+				return static_cast<double>(std::accumulate(first, last, 0));
+			};
+
+			auto cache = ea::fitness::make_cache<DefaultTestGenome>(fn);
+
+			for(int pass = 0; pass < 3; ++pass)
+			{
+				const ea::fitness::FitnessTable a(begin(population), end(population), fn);
+				const ea::fitness::FitnessTable b(begin(population), end(population), cache);
+
+				CPPUNIT_ASSERT(std::equal(a.begin(), a.end(), b.begin()));
+			}
+
+			CPPUNIT_ASSERT(cache.misses() <= population.size());
+			CPPUNIT_ASSERT_EQUAL(size_t(3000), cache.hits() + cache.misses());
+		}
+
+		void mutable_fitness()
+		{
+			size_t calls = 0;
+
+			auto cache = ea::fitness::make_cache<DefaultTestGenome>([&calls, n = size_t(0)](auto first, auto last) mutable
+			{
+				calls = ++n;
+
+				return static_cast<double>(std::accumulate(first, last, 0));
+			});
+
+			DefaultTestGenome a = { 1, 2, 3 };
+			DefaultTestGenome b = { 4, 5, 6 };
+
+			CPPUNIT_ASSERT_EQUAL(6.0, cache(begin(a), end(a)));
+			CPPUNIT_ASSERT_EQUAL(15.0, cache(begin(b), end(b)));
+			CPPUNIT_ASSERT_EQUAL(6.0, cache(begin(a), end(a)));
+
+			CPPUNIT_ASSERT_EQUAL(size_t(2), calls);
+			CPPUNIT_ASSERT_EQUAL(size_t(1), cache.hits());
+		}
+
+		void invalid_args()
+		{
+			auto fn = [](DefaultTestGenome::iterator, DefaultTestGenome::iterator) { return 0.0; };
+
+			CPPUNIT_ASSERT_THROW(ea::fitness::make_cache<DefaultTestGenome>(fn, 0), std::invalid_argument);
+			CPPUNIT_ASSERT_THROW(ea::fitness::make_cache<DefaultTestGenome>(fn, 10, 0), std::invalid_argument);
+		}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FitnessCacheTest);
+
+#include "AsyncFitness.hpp"
+
+class AsyncFitnessTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE(AsyncFitnessTest);
+	CPPUNIT_TEST(batch);
+	CPPUNIT_TEST(submit);
+	CPPUNIT_TEST(exceptions);
+	CPPUNIT_TEST(invalid_args);
+	CPPUNIT_TEST_SUITE_END();
+
+	protected:
+		void batch()
+		{
+			DefaultTestPopulation population(500);
+
+			for(size_t i = 0; i < population.size(); ++i)
+			{
+				ea::random::fill_n_int(std::back_inserter(population[i]), 10, 0, 100);
+			}
+
+			auto fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+			{
+				return static_cast<double>(std::accumulate(first, last, 0));
+			};
+
+			// a queue holding a single task blocks the submitting threads most of the time:
+			auto async = ea::fitness::async(fn, 2, 1);
+
+			CPPUNIT_ASSERT(ea::fitness::is_async_v<decltype(async)>);
+			CPPUNIT_ASSERT((ea::fitness::is_batch_fitness_v<decltype(async), DefaultTestPopulation::iterator>));
+
+			const ea::fitness::FitnessTable a(begin(population), end(population), fn);
+			const ea::fitness::FitnessTable b(begin(population), end(population), async);
+
+			CPPUNIT_ASSERT(std::equal(a.begin(), a.end(), b.begin()));
+
+			CPPUNIT_ASSERT(ea::fitness::fittest(begin(population), end(population), async)
+			               == ea::fitness::fittest(begin(population), end(population), fn));
+		}
+
+		void submit()
+		{
+			auto async = ea::fitness::async([](auto first, auto last)
+			{
+				return static_cast<double>(std::distance(first, last));
+			}, 4);
+
+			std::vector<std::shared_future<double>> futures;
+
+			for(int i = 0; i < 100; ++i)
+			{
+				futures.push_back(async.submit(DefaultTestGenome(i)));
+			}
+
+			for(int i = 0; i < 100; ++i)
+			{
+				CPPUNIT_ASSERT_EQUAL(static_cast<double>(i), futures[i].get());
+			}
+		}
+
+		void exceptions()
+		{
+			auto async = ea::fitness::async([](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last) -> double
+			{
+				if(first == last)
+				{
+					throw std::runtime_error("empty chromosome");
+				}
+
+				return 1.0;
+			}, 2);
+
+			DefaultTestPopulation population = { { 1 }, {}, { 2 } };
+			double out[3];
+
+			CPPUNIT_ASSERT_THROW(async(begin(population), end(population), out), std::runtime_error);
+		}
+
+		void invalid_args()
+		{
+			CPPUNIT_ASSERT_THROW(ea::fitness::ThreadPool(0), std::invalid_argument);
+		}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(AsyncFitnessTest);
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <thread>
+#include <chrono>
+#include <unistd.h>
+
+#include "ProcessFitness.hpp"
+
+class ProcessFitnessTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE(ProcessFitnessTest);
+	CPPUNIT_TEST(batch);
+	CPPUNIT_TEST(crash);
+	CPPUNIT_TEST(timeout);
+	CPPUNIT_TEST(fallback);
+	CPPUNIT_TEST(invalid_args);
+	CPPUNIT_TEST_SUITE_END();
+
+	protected:
+		void batch()
+		{
+			DefaultTestPopulation population(1000);
+
+			for(size_t i = 0; i < population.size(); ++i)
+			{
+				ea::random::fill_n_int(std::back_inserter(population[i]), i % 20, 0, 100);
+			}
+
+			auto fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+			{
+				return static_cast<double>(std::accumulate(first, last, 0));
+			};
+
+			auto pool = ea::fitness::make_process_pool<DefaultTestGenome>(fn, 3);
+
+			CPPUNIT_ASSERT((ea::fitness::is_batch_fitness_v<decltype(pool), DefaultTestPopulation::iterator>));
+			CPPUNIT_ASSERT_EQUAL(std::numeric_limits<size_t>::max(), ea::fitness::batch_size_v<decltype(pool)>);
+
+			const ea::fitness::FitnessTable a(begin(population), end(population), fn);
+			const ea::fitness::FitnessTable b(begin(population), end(population), pool);
+
+			CPPUNIT_ASSERT(std::equal(a.begin(), a.end(), b.begin()));
+			CPPUNIT_ASSERT_EQUAL(size_t(0), pool.failures());
+
+			// batches exceeding the shared memory segment are split:
+			ea::fitness::ProcessPool<DefaultTestGenome, decltype(fn)> small(fn, 2, std::chrono::seconds(60), 0.0, 1024);
+			const ea::fitness::FitnessTable c(begin(population), end(population), small);
+
+			CPPUNIT_ASSERT(std::equal(a.begin(), a.end(), c.begin()));
+
+			DefaultTestPopulation large = { DefaultTestGenome(1024) };
+			double out;
+
+			CPPUNIT_ASSERT_THROW(small(begin(large), end(large), &out), std::length_error);
+		}
+
+		void crash()
+		{
+			auto pool = ea::fitness::make_process_pool<DefaultTestGenome>([](DefaultTestGenome::iterator first, DefaultTestGenome::iterator)
+			{
+				if(*first < 0)
+				{
+					_exit(1);
+				}
+
+				return static_cast<double>(*first);
+			}, 2, std::chrono::seconds(60), -1.0);
+
+			DefaultTestPopulation population = { { 1 }, { 2 }, { -3 }, { 4 } };
+			double out[4];
+
+			pool(begin(population), end(population), out);
+
+			CPPUNIT_ASSERT_EQUAL(1.0, out[0]);
+			CPPUNIT_ASSERT_EQUAL(2.0, out[1]);
+			CPPUNIT_ASSERT_EQUAL(-1.0, out[2]);
+			CPPUNIT_ASSERT_EQUAL(4.0, out[3]);
+			CPPUNIT_ASSERT_EQUAL(size_t(1), pool.failures());
+
+			// the worker has been replaced:
+			population[2][0] = 3;
+			pool(begin(population), end(population), out);
+
+			CPPUNIT_ASSERT_EQUAL(3.0, out[2]);
+		}
+
+		void timeout()
+		{
+			auto pool = ea::fitness::make_process_pool<DefaultTestGenome>([](DefaultTestGenome::iterator first, DefaultTestGenome::iterator)
+			{
+				if(*first < 0)
+				{
+					std::this_thread::sleep_for(std::chrono::seconds(60));
+				}
+
+				return static_cast<double>(*first);
+			}, 2, std::chrono::milliseconds(200), -1.0);
+
+			DefaultTestPopulation population = { { 1 }, { -2 }, { 3 } };
+			double out[3];
+
+			const auto start = std::chrono::steady_clock::now();
+
+			pool(begin(population), end(population), out);
+
+			CPPUNIT_ASSERT(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+			CPPUNIT_ASSERT_EQUAL(1.0, out[0]);
+			CPPUNIT_ASSERT_EQUAL(-1.0, out[1]);
+			CPPUNIT_ASSERT_EQUAL(3.0, out[2]);
+			CPPUNIT_ASSERT_EQUAL(size_t(1), pool.failures());
+		}
+
+		void fallback()
+		{
+			auto fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator)
+			{
+				if(*first < 0)
+				{
+					_exit(1);
+				}
+
+				return static_cast<double>(*first);
+			};
+
+			// crashed chromosomes get the worst fitness value of the comparison:
+			auto maximize = ea::fitness::make_process_pool<DefaultTestGenome>(fn, 2);
+			auto minimize = ea::fitness::make_process_pool<DefaultTestGenome, std::less<double>>(fn, 2);
+
+			DefaultTestPopulation population = { { 1 }, { -2 } };
+			const ea::fitness::FitnessTable a(begin(population), end(population), maximize);
+			const ea::fitness::FitnessTable b(begin(population), end(population), minimize);
+
+			CPPUNIT_ASSERT_EQUAL(-std::numeric_limits<double>::infinity(), a[1]);
+			CPPUNIT_ASSERT_EQUAL(std::numeric_limits<double>::infinity(), b[1]);
+			CPPUNIT_ASSERT_EQUAL(1.0, b[0]);
+		}
+
+		void invalid_args()
+		{
+			auto fn = [](DefaultTestGenome::iterator, DefaultTestGenome::iterator) { return 0.0; };
+
+			CPPUNIT_ASSERT_THROW(ea::fitness::make_process_pool<DefaultTestGenome>(fn, 0), std::invalid_argument);
+		}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ProcessFitnessTest);
+
+#endif
+
+template<typename Selection>
+static void select_children(Selection select, const size_t size = 1000, const size_t count = 100)
+{
+	DefaultTestPopulation population;
+
+	std::generate_n(std::back_inserter(population), size, [&]()
+	{
+		return DefaultTestGenome(10);
+	});
+
+	std::function<double(DefaultTestGenome::iterator, DefaultTestGenome::iterator)>
+	fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+	{
+		return 0.0;
+	};
+
+	DefaultTestPopulation children;
+
+	select(begin(population), end(population), 0, fn, std::back_inserter(children));
+	select(begin(population), end(population), count, fn, std::back_inserter(children));
+
+	CPPUNIT_ASSERT(children.size() == count);
+}
+
+template<typename Compare = std::greater<double>, typename Selection>
+static void fitness_increases(Selection select, const size_t size = 10000, const size_t count = 1000)
+{
+	DefaultTestPopulation population;
+
+	std::generate_n(std::back_inserter(population), size, [&]()
+	{
+		DefaultTestGenome g;
+
+		ea::random::fill_n_int(std::back_inserter(g), 10, -100, 100);
+
+		return g;
+	});
+
+	std::function<double(DefaultTestGenome::iterator, DefaultTestGenome::iterator)>
+	fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+	{
+		return static_cast<double>(std::accumulate(first, last, 0, [](int total, int n) { return total + n; }));
+	};
+
+	DefaultTestPopulation children;
+
+	select(begin(population), end(population), count, fn, std::back_inserter(children));
+
+	double a = ea::fitness::mean(begin(population), end(population), fn);
+	double b = ea::fitness::mean(begin(children), end(children), fn);
+
+	CPPUNIT_ASSERT(Compare()(b, a));
+}
+
+template<typename Selection>
+static void is_subset(Selection select, const size_t size = 1000, const size_t count = 10)
+{
+	DefaultTestPopulation population;
+
+	std::generate_n(std::back_inserter(population), size, [&]()
+	{
+		DefaultTestGenome g;
+
+		ea::random::fill_n_int(std::back_inserter(g), 10, 1, 100);
+
+		return g;
+	});
+
+	std::function<double(DefaultTestGenome::iterator, DefaultTestGenome::iterator)>
+	fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+	{
+		return static_cast<double>(std::accumulate(first, last, 1, [](int factorial, int n) { return factorial * n; }));
+	};
+
+	DefaultTestPopulation children;
+
+	select(begin(population), end(population), count, fn, std::back_inserter(children));
+
+	std::for_each(begin(children), end(children), [&population](auto a)
+	{
+		auto match = std::find_if(begin(population), end(population), [&a](auto b)
+		{
+			bool equal = a.size() == b.size();
+			size_t i = 0;
+
+			while(equal && i < a.size())
+			{
+				equal = a[i] == b[i];
+				++i;
+			}
+
+			return equal;
+		});
+
+		CPPUNIT_ASSERT(match != end(population));
+	});
+}
+
+template<typename Selection>
+static void select_from_table(Selection select, const size_t size = 1000, const size_t count = 100)
+{
+	DefaultTestPopulation population;
+
+	std::generate_n(std::back_inserter(population), size, [&]()
+	{
+		DefaultTestGenome g;
+
+		ea::random::fill_n_int(std::back_inserter(g), 10, -100, 100);
+
+		return g;
+	});
+
+	std::function<double(DefaultTestGenome::iterator, DefaultTestGenome::iterator)>
+	fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+	{
+		return static_cast<double>(std::accumulate(first, last, 0));
+	};
+
+	const ea::fitness::FitnessTable table(begin(population), end(population), fn);
+	DefaultTestPopulation a;
+	DefaultTestPopulation b;
+	DefaultTestPopulation c;
+
+	if constexpr(std::is_invocable_v<Selection &,
+	                                 DefaultTestPopulation::iterator,
+	                                 DefaultTestPopulation::iterator,
+	                                 size_t,
+	                                 decltype(fn),
+	                                 std::back_insert_iterator<DefaultTestPopulation>,
+	                                 ea::random::RandomEngine &>)
+	{
+		ea::random::RandomEngine eng_a(7);
+		ea::random::RandomEngine eng_b(7);
+		ea::random::RandomEngine eng_c(7);
+
+		select(begin(population), end(population), count, fn, std::back_inserter(a), eng_a);
+		select(begin(population), end(population), count, table, std::back_inserter(b), eng_b);
+		select(begin(population), end(population), count, ea::fitness::batch(fn), std::back_inserter(c), eng_c);
+	}
+	else
+	{
+		select(begin(population), end(population), count, fn, std::back_inserter(a));
+		select(begin(population), end(population), count, table, std::back_inserter(b));
+		select(begin(population), end(population), count, ea::fitness::batch(fn), std::back_inserter(c));
+	}
+
+	CPPUNIT_ASSERT(a.size() == count);
+	CPPUNIT_ASSERT(a == b);
+	CPPUNIT_ASSERT(a == c);
+
+	const ea::fitness::FitnessTable too_small(begin(population), end(population) - 1, fn);
+
+	CPPUNIT_ASSERT_THROW(select(begin(population), end(population), count, too_small, std::back_inserter(b)), std::length_error);
+}
+
+// sums positive genes & stops as soon as the partial sum exceeds the cutoff (minimization)
+struct BoundedSum
+{
+	std::atomic<size_t> *aborted;
+
+	double operator()(DefaultTestGenome::iterator first, DefaultTestGenome::iterator last) const
+	{
+		return static_cast<double>(std::accumulate(first, last, 0));
+	}
+
+	std::optional<double> bounded(DefaultTestGenome::iterator first, DefaultTestGenome::iterator last, const double cutoff) const
+	{
+		double sum = 0.0;
+
+		for(auto it = first; it != last; ++it)
+		{
+			sum += *it;
+
+			if(sum > cutoff)
+			{
+				++*aborted;
+
+				return std::nullopt;
+			}
+		}
+
+		return sum;
+	}
+};
+
+template<typename Selection>
+static void select_bounded(Selection select, const size_t size = 1000, const size_t count = 100)
+{
+	DefaultTestPopulation population(size);
+
+	for(auto &g : population)
+	{
+		ea::random::fill_n_int(std::back_inserter(g), 50, 0, 100);
+	}
+
+	std::atomic<size_t> aborted(0);
+	const BoundedSum bounded = { &aborted };
+
+	CPPUNIT_ASSERT((ea::fitness::has_bounded_v<BoundedSum, DefaultTestGenome::iterator>));
+
+	auto fn = [&bounded](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+	{
+		return bounded(first, last);
+	};
+
+	DefaultTestPopulation a;
+	DefaultTestPopulation b;
+
+	if constexpr(std::is_invocable_v<Selection &,
+	                                 DefaultTestPopulation::iterator,
+	                                 DefaultTestPopulation::iterator,
+	                                 size_t,
+	                                 decltype(fn),
+	                                 std::back_insert_iterator<DefaultTestPopulation>,
+	                                 ea::random::RandomEngine &>)
+	{
+		ea::random::RandomEngine eng_a(7);
+		ea::random::RandomEngine eng_b(7);
+
+		select(begin(population), end(population), count, fn, std::back_inserter(a), eng_a);
+		select(begin(population), end(population), count, bounded, std::back_inserter(b), eng_b);
+	}
+	else
+	{
+		select(begin(population), end(population), count, fn, std::back_inserter(a));
+		select(begin(population), end(population), count, bounded, std::back_inserter(b));
+	}
+
+	CPPUNIT_ASSERT(a.size() == count);
+	CPPUNIT_ASSERT(a == b);
+	CPPUNIT_ASSERT(aborted > 0);
+}
+
+template<typename Selection>
+static void select_indices(Selection select, const size_t size = 1000, const size_t count = 100)
+{
+	DefaultTestPopulation population;
+
+	std::generate_n(std::back_inserter(population), size, [&]()
+	{
+		DefaultTestGenome g;
+
+		ea::random::fill_n_int(std::back_inserter(g), 10, -100, 100);
+
+		return g;
+	});
+
+	auto fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+	{
+		return static_cast<double>(std::accumulate(first, last, 0));
+	};
+
+	const ea::fitness::FitnessTable table(begin(population), end(population), fn);
+	DefaultTestPopulation children;
+	std::vector<size_t> indices;
+
+	if constexpr(std::is_invocable_v<Selection &,
+	                                 DefaultTestPopulation::iterator,
+	                                 DefaultTestPopulation::iterator,
+	                                 size_t,
+	                                 decltype(fn),
+	                                 std::back_insert_iterator<DefaultTestPopulation>,
+	                                 ea::random::RandomEngine &>)
+	{
+		ea::random::RandomEngine eng_a(7);
+		ea::random::RandomEngine eng_b(7);
+
+		select(begin(population), end(population), count, table, std::back_inserter(children), eng_a);
+		select.select_indices(begin(population), end(population), count, table, std::back_inserter(indices), eng_b);
+	}
+	else
+	{
+		select(begin(population), end(population), count, table, std::back_inserter(children));
+		select.select_indices(begin(population), end(population), count, table, std::back_inserter(indices));
+	}
+
+	CPPUNIT_ASSERT(indices.size() == count);
+	CPPUNIT_ASSERT(std::all_of(begin(indices), end(indices), [size](const size_t index) { return index < size; }));
+
+	DefaultTestPopulation gathered;
+
+	ea::utils::gather(begin(population), begin(indices), end(indices), std::back_inserter(gathered));
+
+	CPPUNIT_ASSERT(gathered == children);
+}
+
+template<typename Error, typename Selection>
+void select_error(Selection op, size_t size = 0, size_t count = 0)
+{
+	DefaultTestPopulation population;
+
+	std::generate_n(std::back_inserter(population), size, [&]()
+	{
+		DefaultTestGenome g;
+
+		ea::random::fill_n_int(std::back_inserter(g), 10, -100, 100);
+
+		return g;
+	});
+
+	DefaultTestPopulation children; 
+
+	std::function<double(DefaultTestGenome::iterator, DefaultTestGenome::iterator)>
+	fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+	{
+		return 0;
+	};
+
+	CPPUNIT_ASSERT_THROW(op(begin(population), end(population), count, fn, std::back_inserter(children)), Error);
+}
+
+#include "Init.hpp"
+
+class InitTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE(InitTest);
+	CPPUNIT_TEST(permutations);
+	CPPUNIT_TEST(bitstrings);
+	CPPUNIT_TEST(reals);
+	CPPUNIT_TEST(reproducible);
+	CPPUNIT_TEST_SUITE_END();
+
+	protected:
+		void permutations()
+		{
+			DefaultTestPopulation population(100, DefaultTestGenome(50));
+
+			ea::init::permutations(begin(population), end(population));
+
+			for(auto &chromosome : population)
+			{
+				DefaultTestGenome sorted(chromosome);
+
+				std::sort(begin(sorted), end(sorted));
+
+				for(int i = 0; i < 50; ++i)
+				{
+					CPPUNIT_ASSERT_EQUAL(i, sorted[i]);
+				}
+			}
+
+			CPPUNIT_ASSERT(population[0] != population[1]);
+		}
+
+		void bitstrings()
+		{
+			std::vector<std::vector<bool>> population(100, std::vector<bool>(1000));
+
+			ea::init::bitstrings(begin(population), end(population));
+
+			size_t ones = 0;
+
+			for(auto &chromosome : population)
+			{
+				ones += std::count(begin(chromosome), end(chromosome), true);
+			}
+
+			CPPUNIT_ASSERT(ones > 49000 && ones < 51000);
+		}
+
+		void reals()
+		{
+			std::vector<std::vector<double>> population(100, std::vector<double>(100));
+
+			ea::init::reals(begin(population), end(population), -5.0, 5.0);
+
+			for(auto &chromosome : population)
+			{
+				CPPUNIT_ASSERT(std::all_of(begin(chromosome), end(chromosome), [](double g) { return g >= -5.0 && g < 5.0; }));
+			}
+		}
+
+		void reproducible()
+		{
+			DefaultTestPopulation a(100, DefaultTestGenome(20));
+			DefaultTestPopulation b(a);
+			ea::random::RandomEngine eng_a(42);
+			ea::random::RandomEngine eng_b(42);
+
+			ea::init::permutations(begin(a), end(a), eng_a);
+			ea::init::permutations(begin(b), end(b), eng_b);
+
+			CPPUNIT_ASSERT(a == b);
+		}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(InitTest);
+
+#include "Surrogate.hpp"
+#include "TournamentSelection.hpp"
+#include "DoubleTournamentSelection.hpp"
+#include "FittestSelection.hpp"
+#include "Stream.hpp"
+
+class SurrogateTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE(SurrogateTest);
+	CPPUNIT_TEST(budget);
+	CPPUNIT_TEST(quota);
+	CPPUNIT_TEST(archive);
+	CPPUNIT_TEST(selection);
+	CPPUNIT_TEST(invalid_args);
+	CPPUNIT_TEST_SUITE_END();
+
+	protected:
+		void budget()
+		{
+			DefaultTestPopulation population(1000, DefaultTestGenome(32));
+
+			ea::init::bitstrings(begin(population), end(population));
+
+			std::atomic<size_t> calls(0);
+			auto surrogate = ea::fitness::make_surrogate<DefaultTestGenome>([&calls](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+			{
+				++calls;
+
+				return static_cast<double>(std::count(first, last, 1));
+			}, 0.1);
+
+			ea::fitness::FitnessTable table(begin(population), end(population), surrogate);
+
+			CPPUNIT_ASSERT_EQUAL(calls.load(), surrogate.evaluations());
+			CPPUNIT_ASSERT_EQUAL(population.size(), surrogate.evaluations() + surrogate.predictions());
+			CPPUNIT_ASSERT(surrogate.evaluations() < population.size() / 2);
+			CPPUNIT_ASSERT(surrogate.predictions() > 0);
+			CPPUNIT_ASSERT_EQUAL(surrogate.evaluations(), surrogate.size());
+		}
+
+		void quota()
+		{
+			DefaultTestPopulation population(1000, DefaultTestGenome(32));
+
+			ea::init::bitstrings(begin(population), end(population));
+
+			auto fn = [](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+			{
+				return static_cast<double>(std::count(first, last, 1));
+			};
+
+			// FitnessTable passes the whole population, k chromosomes build the model:
+			auto table = ea::fitness::make_surrogate<DefaultTestGenome>(fn, 0.1);
+
+			ea::fitness::FitnessTable(begin(population), end(population), table);
+
+			CPPUNIT_ASSERT_EQUAL(size_t(5 + 100), table.evaluations());
+
+			// streams evaluate unknown individuals in a single call:
+			auto streamed = ea::fitness::make_surrogate<DefaultTestGenome>(fn, 0.1);
+
+			ea::stream::make_mutable(begin(population), end(population), 7).evaluate(streamed);
+
+			CPPUNIT_ASSERT_EQUAL(size_t(5 + 100), streamed.evaluations());
+
+			// the quota holds for single chromosomes, too:
+			auto single = ea::fitness::make_surrogate<DefaultTestGenome>(fn, 0.1);
+
+			for(auto it = begin(population); it != end(population); ++it)
+			{
+				double out;
+
+				single(it, std::next(it), &out);
+			}
+
+			CPPUNIT_ASSERT_EQUAL(size_t(5 + 100), single.evaluations());
+			CPPUNIT_ASSERT_EQUAL(population.size(), single.evaluations() + single.predictions());
+		}
+
+		void archive()
+		{
+			size_t calls = 0;
+			auto surrogate = ea::fitness::make_surrogate<std::vector<double>>([&calls](std::vector<double>::iterator first, std::vector<double>::iterator)
+			{
+				++calls;
+
+				return *first;
+			}, 1.0, 2, 3);
+
+			std::vector<std::vector<double>> population = { { 1.0 }, { 2.0 }, { 3.0 }, { 4.0 } };
+			double out[4];
+
+			surrogate(begin(population), end(population), out);
+
+			CPPUNIT_ASSERT_EQUAL(size_t(4), calls);
+			CPPUNIT_ASSERT_EQUAL(size_t(3), surrogate.size());
+			CPPUNIT_ASSERT_EQUAL(4.0, out[3]);
+
+			// archived chromosomes aren't evaluated again:
+			std::vector<std::vector<double>> archived = { { 4.0 } };
+
+			surrogate(begin(archived), end(archived), out);
+
+			CPPUNIT_ASSERT_EQUAL(size_t(4), calls);
+			CPPUNIT_ASSERT_EQUAL(4.0, out[0]);
+			CPPUNIT_ASSERT_EQUAL(size_t(1), surrogate.predictions());
+		}
+
+		void selection()
+		{
+			DefaultTestPopulation population(500, DefaultTestGenome(16));
+
+			ea::init::bitstrings(begin(population), end(population));
+
+			auto surrogate = ea::fitness::make_surrogate<DefaultTestGenome>([](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last)
+			{
+				return static_cast<double>(std::count(first, last, 1));
+			});
+
+			DefaultTestPopulation selected;
+
+			ea::selection::Tournament()(begin(population), end(population), 50, surrogate, std::back_inserter(selected));
+			ea::selection::DoubleTournament()(begin(population), end(population), 50, surrogate, std::back_inserter(selected));
+			ea::selection::Fittest()(begin(population), end(population), 50, surrogate, std::back_inserter(selected));
+
+			CPPUNIT_ASSERT_EQUAL(size_t(150), selected.size());
+			CPPUNIT_ASSERT(surrogate.predictions() > 0);
+		}
+
+		void invalid_args()
+		{
+			auto fn = [](DefaultTestGenome::iterator, DefaultTestGenome::iterator) { return 0.0; };
+
+			CPPUNIT_ASSERT_THROW(ea::fitness::make_surrogate<DefaultTestGenome>(fn, 0.0), std::invalid_argument);
+			CPPUNIT_ASSERT_THROW(ea::fitness::make_surrogate<DefaultTestGenome>(fn, 1.5), std::invalid_argument);
+			CPPUNIT_ASSERT_THROW(ea::fitness::make_surrogate<DefaultTestGenome>(fn, 0.5, 0), std::invalid_argument);
+			CPPUNIT_ASSERT_THROW(ea::fitness::make_surrogate<DefaultTestGenome>(fn, 0.5, 5, 0), std::invalid_argument);
+		}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SurrogateTest);
+
+#include "TournamentSelection.hpp"
+
+class TournamentSelectionTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE(TournamentSelectionTest);
 	CPPUNIT_TEST(select_children);
 	CPPUNIT_TEST(fitness_increases);
 	CPPUNIT_TEST(is_subset);
+	CPPUNIT_TEST(select_from_table);
+	CPPUNIT_TEST(select_indices);
+	CPPUNIT_TEST(select_bounded);
+	CPPUNIT_TEST(reproducible);
+	CPPUNIT_TEST(mutable_fitness);
 	CPPUNIT_TEST(invalid_args);
 	CPPUNIT_TEST_SUITE_END();
 
@@ -545,6 +1926,88 @@ class TournamentSelectionTest : public CPPUNIT_NS::TestFixture
 			::is_subset(ea::selection::Tournament<>());
 		}
 
+		void select_from_table()
+		{
+			::select_from_table(ea::selection::Tournament<>());
+		}
+
+		void select_indices()
+		{
+			::select_indices(ea::selection::Tournament<>());
+		}
+
+		void select_bounded()
+		{
+			::select_bounded(ea::selection::Tournament<std::less<double>>());
+		}
+
+		void reproducible()
+		{
+			std::vector<double> values;
+
+			ea::random::fill_n_int(std::back_inserter(values), 10000, 0, 1000);
+
+			const ea::fitness::FitnessTable table(values);
+			std::vector<size_t> population(values.size());
+
+			std::iota(std::begin(population), std::end(population), 0);
+
+			auto run = [&](const int threads, const size_t Q)
+			{
+#ifdef _OPENMP
+				omp_set_num_threads(threads);
+#endif
+				std::mt19937_64 eng(42);
+				std::vector<size_t> selected;
+
+				const ea::selection::Tournament<> op(Q);
+
+				op(std::begin(population), std::end(population), 5000, table, std::back_inserter(selected), eng);
+
+				return selected;
+			};
+
+			// opponents on the stack & in a heap buffer:
+			for(const size_t Q : { 3, 20 })
+			{
+				const auto a = run(1, Q);
+				const auto b = run(4, Q);
+
+				CPPUNIT_ASSERT(a.size() == 5000);
+				CPPUNIT_ASSERT(a == b);
+			}
+
+#ifdef _OPENMP
+			omp_set_num_threads(omp_get_num_procs());
+#endif
+		}
+
+		void mutable_fitness()
+		{
+			DefaultTestPopulation population(100, DefaultTestGenome(10));
+
+			for(auto &g : population)
+			{
+				ea::random::fill_n_int(begin(g), 10, 0, 100);
+			}
+
+			std::atomic<size_t> calls(0);
+
+			auto fn = [calls = &calls](DefaultTestGenome::iterator first, DefaultTestGenome::iterator last) mutable
+			{
+				++*calls;
+
+				return static_cast<double>(std::accumulate(first, last, 0));
+			};
+
+			DefaultTestPopulation selected;
+
+			ea::selection::Tournament<>()(begin(population), end(population), 50, fn, std::back_inserter(selected));
+
+			CPPUNIT_ASSERT_EQUAL(size_t(50), selected.size());
+			CPPUNIT_ASSERT(calls > 0 && calls <= population.size());
+		}
+
 		void invalid_args()
 		{
 			CPPUNIT_ASSERT_THROW(ea::selection::Tournament<>(0), std::invalid_argument);
@@ -565,6 +2028,9 @@ class DoubleTournamentSelectionTest : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST(select_children);
 	CPPUNIT_TEST(fitness_increases);
 	CPPUNIT_TEST(is_subset);
+	CPPUNIT_TEST(select_from_table);
+	CPPUNIT_TEST(select_indices);
+	CPPUNIT_TEST(reproducible);
 	CPPUNIT_TEST(invalid_args);
 	CPPUNIT_TEST_SUITE_END();
 
@@ -585,6 +2051,52 @@ class DoubleTournamentSelectionTest : public CPPUNIT_NS::TestFixture
 			::fitness_increases<std::less<double>>(ea::selection::DoubleTournament<std::less<double>>());
 		}
 
+		void select_from_table()
+		{
+			::select_from_table(ea::selection::DoubleTournament<>());
+		}
+
+		void select_indices()
+		{
+			::select_indices(ea::selection::DoubleTournament<>());
+		}
+
+		void reproducible()
+		{
+			std::vector<double> values;
+
+			// few distinct values, many individuals share their number of victories:
+			ea::random::fill_n_int(std::back_inserter(values), 10000, 0, 10);
+
+			const ea::fitness::FitnessTable table(values);
+			std::vector<size_t> population(values.size());
+
+			std::iota(std::begin(population), std::end(population), 0);
+
+			auto run = [&](const int threads)
+			{
+#ifdef _OPENMP
+				omp_set_num_threads(threads);
+#endif
+				std::mt19937_64 eng(42);
+				std::vector<size_t> selected;
+
+				ea::selection::DoubleTournament<>()(std::begin(population), std::end(population), 500, table, std::back_inserter(selected), eng);
+
+				return selected;
+			};
+
+			const auto a = run(1);
+			const auto b = run(4);
+
+#ifdef _OPENMP
+			omp_set_num_threads(omp_get_num_procs());
+#endif
+
+			CPPUNIT_ASSERT(a.size() == 500);
+			CPPUNIT_ASSERT(a == b);
+		}
+
 		void invalid_args()
 		{
 			CPPUNIT_ASSERT_THROW(ea::selection::DoubleTournament<>(0), std::invalid_argument);
@@ -606,6 +2118,10 @@ class FittestSelectionTest : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST(select_children);
 	CPPUNIT_TEST(fitness_increases);
 	CPPUNIT_TEST(is_subset);
+	CPPUNIT_TEST(select_from_table);
+	CPPUNIT_TEST(select_indices);
+	CPPUNIT_TEST(select_bounded);
+	CPPUNIT_TEST(top_k);
 	CPPUNIT_TEST(invalid_args);
 	CPPUNIT_TEST_SUITE_END();
 
@@ -615,26 +2131,312 @@ class FittestSelectionTest : public CPPUNIT_NS::TestFixture
 			::select_children(ea::selection::Fittest<>());
 		}
 
-		void fitness_increases()
-		{
-			::fitness_increases(ea::selection::Fittest<>());
-			::fitness_increases<std::less<double>>(ea::selection::Fittest<std::less<double>>());
+		void fitness_increases()
+		{
+			::fitness_increases(ea::selection::Fittest<>());
+			::fitness_increases<std::less<double>>(ea::selection::Fittest<std::less<double>>());
+		}
+
+		void is_subset()
+		{
+			::is_subset(ea::selection::Fittest<>());
+		}
+
+		void select_from_table()
+		{
+			::select_from_table(ea::selection::Fittest<>());
+		}
+
+		void select_indices()
+		{
+			::select_indices(ea::selection::Fittest<>());
+		}
+
+		void select_bounded()
+		{
+			::select_bounded(ea::selection::Fittest<std::less<double>>());
+		}
+
+		void top_k()
+		{
+			std::vector<double> values;
+
+			ea::random::fill_n_int(std::back_inserter(values), 200000, 0, 1000);
+
+			std::vector<size_t> population(values.size());
+
+			std::iota(std::begin(population), std::end(population), 0);
+
+			std::vector<size_t> expected(population);
+
+			std::stable_sort(std::begin(expected), std::end(expected), [&values](size_t a, size_t b)
+			{
+				return values[a] > values[b];
+			});
+
+			const ea::fitness::FitnessTable table(values);
+
+			// bounded heaps & chunked nth_element:
+			for(const size_t N : { 1, 3, 256, 257, 5000, 200000 })
+			{
+				std::vector<size_t> selected;
+
+				ea::selection::Fittest<>()(std::begin(population), std::end(population), N, table, std::back_inserter(selected));
+
+				CPPUNIT_ASSERT(std::equal(std::begin(selected), std::end(selected), std::begin(expected), std::begin(expected) + N));
+			}
+		}
+
+		void invalid_args()
+		{
+			ea::selection::Fittest<> op;
+
+			select_error<std::length_error>(op, 10, 11);
+		}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FittestSelectionTest);
+
+#include "Pareto.hpp"
+
+class ParetoTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE(ParetoTest);
+	CPPUNIT_TEST(dominates);
+	CPPUNIT_TEST(fronts);
+	CPPUNIT_TEST(brute_force);
+	CPPUNIT_TEST(crowding_distance);
+	CPPUNIT_TEST(invalid_args);
+	CPPUNIT_TEST_SUITE_END();
+
+	protected:
+		void dominates()
+		{
+			const double a[] = { 2.0, 2.0 };
+			const double b[] = { 1.0, 2.0 };
+			const double c[] = { 3.0, 1.0 };
+
+			CPPUNIT_ASSERT(ea::pareto::dominates(a, b, 2));
+			CPPUNIT_ASSERT(!ea::pareto::dominates(b, a, 2));
+			CPPUNIT_ASSERT(!ea::pareto::dominates(a, a, 2));
+			CPPUNIT_ASSERT(!ea::pareto::dominates(a, c, 2));
+			CPPUNIT_ASSERT(!ea::pareto::dominates(c, a, 2));
+			CPPUNIT_ASSERT(ea::pareto::dominates<std::less<double>>(b, a, 2));
+		}
+
+		void fronts()
+		{
+			const ea::pareto::ObjectiveTable table({ 1.0, 1.0,
+			                                         3.0, 1.0,
+			                                         2.0, 2.0,
+			                                         1.0, 3.0,
+			                                         2.0, 2.0,
+			                                         0.0, 0.0,
+			                                         1.0, 2.0 }, 2);
+
+			const std::vector<size_t> expected = { 2, 0, 0, 0, 0, 3, 1 };
+
+			CPPUNIT_ASSERT(ea::pareto::non_dominated_sort(table) == expected);
+
+			const std::vector<size_t> minimized = { 1, 2, 3, 3, 3, 0, 2 };
+
+			CPPUNIT_ASSERT(ea::pareto::non_dominated_sort<std::less<double>>(table) == minimized);
+		}
+
+		void brute_force()
+		{
+			for(const size_t m : { 1, 2, 3, 5 })
+			{
+				std::vector<double> values;
+
+				ea::random::fill_n_int(std::back_inserter(values), 500 * m, 0, 20);
+
+				const ea::pareto::ObjectiveTable table(values, m);
+
+				CPPUNIT_ASSERT(ea::pareto::non_dominated_sort(table) == fast_non_dominated_sort<std::greater<double>>(table));
+				CPPUNIT_ASSERT(ea::pareto::non_dominated_sort<std::less<double>>(table) == fast_non_dominated_sort<std::less<double>>(table));
+			}
+		}
+
+		void crowding_distance()
+		{
+			const ea::pareto::ObjectiveTable table({ 0.0, 4.0,
+			                                         1.0, 3.0,
+			                                         4.0, 0.0,
+			                                         3.0, 1.0,
+			                                         0.0, 0.0 }, 2);
+
+			const auto ranks = ea::pareto::non_dominated_sort(table);
+			const auto distances = ea::pareto::crowding_distance(table, ranks);
+
+			CPPUNIT_ASSERT(std::isinf(distances[0]));
+			CPPUNIT_ASSERT(std::isinf(distances[2]));
+			CPPUNIT_ASSERT(std::isinf(distances[4]));
+			CPPUNIT_ASSERT(std::abs(distances[1] - 1.5) < 1e-12);
+			CPPUNIT_ASSERT(std::abs(distances[3] - 1.5) < 1e-12);
+		}
+
+		void invalid_args()
+		{
+			CPPUNIT_ASSERT_THROW(ea::pareto::ObjectiveTable({ 1.0 }, 0), std::invalid_argument);
+			CPPUNIT_ASSERT_THROW(ea::pareto::ObjectiveTable({ 1.0, 2.0, 3.0 }, 2), std::length_error);
+
+			std::vector<std::vector<int>> population = { { 1 }, { 1, 2 } };
+
+			CPPUNIT_ASSERT_THROW(ea::pareto::ObjectiveTable(std::begin(population), std::end(population), [](auto first, auto last)
+			{
+				return ea::pareto::Objectives(first, last);
+			}), std::length_error);
+
+			const ea::pareto::ObjectiveTable table({ 1.0, 2.0 }, 1);
+
+			CPPUNIT_ASSERT_THROW(ea::pareto::crowding_distance(table, { 0 }), std::length_error);
+		}
+
+	private:
+		// Deb's O(M N^2) fast-non-dominated-sort
+		template<typename Compare>
+		static std::vector<size_t> fast_non_dominated_sort(const ea::pareto::ObjectiveTable &table)
+		{
+			const size_t length = table.size();
+			std::vector<std::vector<size_t>> dominated(length);
+			std::vector<size_t> counts(length, 0);
+			std::vector<size_t> ranks(length, 0);
+			std::vector<size_t> front;
+
+			for(size_t i = 0; i < length; ++i)
+			{
+				for(size_t j = 0; j < length; ++j)
+				{
+					if(ea::pareto::dominates<Compare>(table[i], table[j], table.objectives()))
+					{
+						dominated[i].push_back(j);
+					}
+					else if(ea::pareto::dominates<Compare>(table[j], table[i], table.objectives()))
+					{
+						++counts[i];
+					}
+				}
+
+				if(counts[i] == 0)
+				{
+					front.push_back(i);
+				}
+			}
+
+			for(size_t rank = 0; !front.empty(); ++rank)
+			{
+				std::vector<size_t> next;
+
+				for(const size_t i : front)
+				{
+					ranks[i] = rank;
+
+					for(const size_t j : dominated[i])
+					{
+						if(--counts[j] == 0)
+						{
+							next.push_back(j);
+						}
+					}
+				}
+
+				front = std::move(next);
+			}
+
+			return ranks;
+		}
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ParetoTest);
+
+#include "ParetoTournamentSelection.hpp"
+
+class ParetoTournamentSelectionTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE(ParetoTournamentSelectionTest);
+	CPPUNIT_TEST(select_dominating);
+	CPPUNIT_TEST(select_from_table);
+	CPPUNIT_TEST(invalid_args);
+	CPPUNIT_TEST_SUITE_END();
+
+	protected:
+		void select_dominating()
+		{
+			std::vector<std::vector<int>> population;
+
+			for(int i = 0; i < 20; ++i)
+			{
+				population.push_back({ i, 19 - i });
+			}
+
+			population.push_back({ 20, 20 });
+
+			auto fn = [](auto first, auto last)
+			{
+				return ea::pareto::Objectives(first, last);
+			};
+
+			std::vector<std::vector<int>> selected;
+
+			ea::selection::ParetoTournament<>(20)(std::begin(population), std::end(population), 10, fn, std::back_inserter(selected));
+
+			CPPUNIT_ASSERT(selected.size() == 10);
+
+			for(const auto &s : selected)
+			{
+				CPPUNIT_ASSERT(s == std::vector<int>({ 20, 20 }));
+			}
+
+			selected.clear();
+
+			ea::selection::ParetoTournament<std::less<double>>(20)(std::begin(population), std::end(population), 10, fn, std::back_inserter(selected));
+
+			for(const auto &s : selected)
+			{
+				CPPUNIT_ASSERT(s != std::vector<int>({ 20, 20 }));
+				CPPUNIT_ASSERT(s[0] == 0 || s[0] == 19);
+			}
 		}
 
-		void is_subset()
+		void select_from_table()
 		{
-			::is_subset(ea::selection::Fittest<>());
+			std::vector<int> population = { 0, 1, 2, 3 };
+			const ea::pareto::ObjectiveTable table({ 0.0, 0.0,
+			                                         1.0, 1.0,
+			                                         3.0, 3.0,
+			                                         2.0, 2.0 }, 2);
+			std::vector<int> selected;
+
+			ea::selection::ParetoTournament<>(3)(std::begin(population), std::end(population), 5, table, std::back_inserter(selected));
+
+			CPPUNIT_ASSERT(selected == std::vector<int>(5, 2));
+
+			std::vector<size_t> indices;
+
+			ea::selection::ParetoTournament<>(3).select_indices(std::begin(population), std::end(population), 5, table, std::back_inserter(indices));
+
+			CPPUNIT_ASSERT(indices == std::vector<size_t>(5, 2));
 		}
 
 		void invalid_args()
 		{
-			ea::selection::Fittest<> op;
+			CPPUNIT_ASSERT_THROW(ea::selection::ParetoTournament<>(0), std::invalid_argument);
 
-			select_error<std::length_error>(op, 10, 11);
+			std::vector<int> population = { 0, 1, 2 };
+			std::vector<int> selected;
+
+			CPPUNIT_ASSERT_THROW(ea::selection::ParetoTournament<>(3)(std::begin(population), std::end(population), 1,
+			                                                          ea::pareto::ObjectiveTable({ 0.0, 1.0, 2.0 }, 1),
+			                                                          std::back_inserter(selected)), std::length_error);
+
+			CPPUNIT_ASSERT_THROW(ea::selection::ParetoTournament<>()(std::begin(population), std::end(population), 1,
+			                                                         ea::pareto::ObjectiveTable({ 0.0, 1.0 }, 1),
+			                                                         std::back_inserter(selected)), std::length_error);
 		}
 };
 
-CPPUNIT_TEST_SUITE_REGISTRATION(FittestSelectionTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(ParetoTournamentSelectionTest);
 
 #include "FitnessProportionalSelection.hpp"
 
@@ -644,6 +2446,10 @@ class FitnessProportionalSelection : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST(select_children);
 	CPPUNIT_TEST(fitness_increases);
 	CPPUNIT_TEST(is_subset);
+	CPPUNIT_TEST(select_from_table);
+	CPPUNIT_TEST(select_indices);
+	CPPUNIT_TEST(alias_table);
+	CPPUNIT_TEST(reproducible);
 	CPPUNIT_TEST(invalid_args);
 	CPPUNIT_TEST_SUITE_END();
 
@@ -664,11 +2470,117 @@ class FitnessProportionalSelection : public CPPUNIT_NS::TestFixture
 			::is_subset(ea::selection::FitnessProportional());
 		}
 
+		void select_from_table()
+		{
+			::select_from_table(ea::selection::FitnessProportional());
+		}
+
+		void select_indices()
+		{
+			::select_indices(ea::selection::FitnessProportional());
+		}
+
+		void alias_table()
+		{
+			const ea::fitness::FitnessTable table(std::vector<double>({ 1.0, 2.0, 0.0, 5.0, 2.0 }));
+			const ea::selection::AliasTable direct(table);
+			const ea::selection::AliasTable inverse(table, ea::selection::Proportionality::inverse);
+
+			// inverse proportionality swaps the weights of the i-th lowest and i-th highest value:
+			const std::vector<double> expected_direct = { 0.1, 0.2, 0.0, 0.5, 0.2 };
+			const std::vector<double> expected_inverse = { 0.2, 0.2, 0.5, 0.0, 0.1 };
+
+			for(auto [alias, expected] : { std::make_pair(&direct, &expected_direct), std::make_pair(&inverse, &expected_inverse) })
+			{
+				std::vector<size_t> counts(alias->size(), 0);
+				const size_t draws = 200000;
+
+				for(size_t i = 0; i < draws; ++i)
+				{
+					++counts[(*alias)(ea::random::thread_engine())];
+				}
+
+				for(size_t i = 0; i < counts.size(); ++i)
+				{
+					CPPUNIT_ASSERT(std::abs(static_cast<double>(counts[i]) / draws - (*expected)[i]) < 0.01);
+				}
+			}
+
+			// the table can be reused:
+			std::vector<int> population = { 0, 1, 2, 3, 4 };
+			std::vector<int> selected;
+
+			for(int i = 0; i < 3; ++i)
+			{
+				ea::selection::FitnessProportional()(std::begin(population), std::end(population), 100, direct, std::back_inserter(selected));
+			}
+
+			CPPUNIT_ASSERT(selected.size() == 300);
+			CPPUNIT_ASSERT(std::find(std::begin(selected), std::end(selected), 2) == std::end(selected));
+
+			// all fitness values zero:
+			const ea::selection::AliasTable zero(ea::fitness::FitnessTable(std::vector<double>(4, 0.0)));
+
+			CPPUNIT_ASSERT(zero(ea::random::thread_engine()) == 0);
+		}
+
+		void reproducible()
+		{
+			std::vector<double> values(300000);
+			std::mt19937_64 gen(7);
+			std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+			// magnitudes differ, so the grouping of the sum matters:
+			for(size_t i = 0; i < values.size(); ++i)
+			{
+				values[i] = dist(gen) * std::pow(10.0, static_cast<double>(i % 12));
+			}
+
+			const ea::fitness::FitnessTable table(values);
+
+			auto run = [&](const int threads)
+			{
+#ifdef _OPENMP
+				omp_set_num_threads(threads);
+#endif
+				const ea::selection::AliasTable alias(table);
+				std::mt19937_64 eng(42);
+				std::vector<size_t> indices;
+
+				for(size_t i = 0; i < 10000; ++i)
+				{
+					indices.push_back(alias(eng));
+				}
+
+				return indices;
+			};
+
+			const auto a = run(1);
+			const auto b = run(4);
+
+#ifdef _OPENMP
+			omp_set_num_threads(omp_get_num_procs());
+#endif
+
+			CPPUNIT_ASSERT(a == b);
+		}
+
 		void invalid_args()
 		{
 			ea::selection::FitnessProportional op;
 
 			select_error<std::length_error>(op, 0, 1);
+
+			const double max = std::numeric_limits<double>::max();
+
+			CPPUNIT_ASSERT_THROW(ea::selection::AliasTable(ea::fitness::FitnessTable(std::vector<double>({ max, max }))), std::overflow_error);
+			CPPUNIT_ASSERT_THROW(ea::selection::AliasTable()(ea::random::thread_engine()), std::length_error);
+
+			std::vector<int> population = { 0, 1, 2 };
+			std::vector<int> selected;
+			const ea::selection::AliasTable table(ea::fitness::FitnessTable(std::vector<double>({ 1.0, 2.0 })));
+
+			CPPUNIT_ASSERT_THROW(op(std::begin(population), std::end(population), 1, table, std::back_inserter(selected)), std::length_error);
 		}
 };
 
@@ -682,6 +2594,9 @@ class StochasticUniversalSamplingTest : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST(select_children);
 	CPPUNIT_TEST(fitness_increases);
 	CPPUNIT_TEST(is_subset);
+	CPPUNIT_TEST(select_from_table);
+	CPPUNIT_TEST(select_indices);
+	CPPUNIT_TEST(expected_counts);
 	CPPUNIT_TEST(invalid_args);
 	CPPUNIT_TEST_SUITE_END();
 
@@ -701,11 +2616,79 @@ class StochasticUniversalSamplingTest : public CPPUNIT_NS::TestFixture
 			::is_subset(ea::selection::StochasticUniversalSampling());
 		}
 
+		void select_from_table()
+		{
+			::select_from_table(ea::selection::StochasticUniversalSampling());
+		}
+
+		void select_indices()
+		{
+			::select_indices(ea::selection::StochasticUniversalSampling());
+		}
+
+		void expected_counts()
+		{
+			std::vector<double> values;
+
+			ea::random::fill_n_int(std::back_inserter(values), 200000, 1, 100);
+
+			const ea::fitness::FitnessTable table(values);
+			const double total = std::accumulate(std::begin(values), std::end(values), 0.0);
+			std::vector<size_t> population(values.size());
+
+			std::iota(std::begin(population), std::end(population), 0);
+
+			auto run = [&](const int threads)
+			{
+#ifdef _OPENMP
+				omp_set_num_threads(threads);
+#endif
+				std::mt19937_64 eng(42);
+				std::vector<size_t> selected;
+
+				ea::selection::StochasticUniversalSampling()(std::begin(population), std::end(population), 150000, table, std::back_inserter(selected), eng);
+
+				return selected;
+			};
+
+			const auto a = run(1);
+			const auto b = run(4);
+
+#ifdef _OPENMP
+			omp_set_num_threads(omp_get_num_procs());
+#endif
+
+			CPPUNIT_ASSERT(a == b);
+			CPPUNIT_ASSERT(std::is_sorted(std::begin(a), std::end(a)));
+
+			// each individual is selected floor or ceil of its expected number of times:
+			std::vector<size_t> counts(values.size(), 0);
+
+			for(const size_t index : a)
+			{
+				++counts[index];
+			}
+
+			for(size_t i = 0; i < values.size(); ++i)
+			{
+				const double expected = values[i] / total * a.size();
+
+				CPPUNIT_ASSERT(counts[i] + 1 > expected && counts[i] < expected + 1);
+			}
+		}
+
 		void invalid_args()
 		{
 			ea::selection::StochasticUniversalSampling op;
 
 			select_error<std::length_error>(op, 0, 1);
+
+			const double max = std::numeric_limits<double>::max();
+			std::vector<int> population = { 0, 1 };
+			std::vector<int> selected;
+
+			CPPUNIT_ASSERT_THROW(op(std::begin(population), std::end(population), 1, ea::fitness::FitnessTable(std::vector<double>({ max, max })),
+			                        std::back_inserter(selected)), std::overflow_error);
 		}
 };
 
@@ -717,6 +2700,7 @@ class BitStringMutationTest : public CPPUNIT_NS::TestFixture
 {
 	CPPUNIT_TEST_SUITE(BitStringMutationTest);
 	CPPUNIT_TEST(mutate);
+	CPPUNIT_TEST(mutate_sparse);
 	CPPUNIT_TEST(invalid_args);
 	CPPUNIT_TEST_SUITE_END();
 
@@ -738,6 +2722,21 @@ class BitStringMutationTest : public CPPUNIT_NS::TestFixture
 			CPPUNIT_ASSERT(std::equal(begin(a), end(a), begin(b)) == false);
 		}
 
+		void mutate_sparse()
+		{
+			std::vector<bool> a(100000);
+			const ea::mutation::BitString mutation(0.0000001, ea::random::BernoulliSampling::skip);
+
+			for(int i = 0; i < 10; ++i)
+			{
+				mutation(begin(a), end(a));
+			}
+
+			const auto flipped = std::count(begin(a), end(a), true);
+
+			CPPUNIT_ASSERT(flipped >= 1 && flipped <= 12);
+		}
+
 		void invalid_args()
 		{
 			CPPUNIT_ASSERT_THROW(ea::mutation::BitString(-0.1), std::invalid_argument);
@@ -1245,6 +3244,8 @@ class DiversityTest : public CPPUNIT_NS::TestFixture
 
 CPPUNIT_TEST_SUITE_REGISTRATION(DiversityTest);
 
+#include <mutex>
+
 #include "Stream.hpp"
 
 typedef uint8_t City;
@@ -1288,6 +3289,13 @@ class StreamTest : public CPPUNIT_NS::TestFixture
 {
 	CPPUNIT_TEST_SUITE(StreamTest);
 	CPPUNIT_TEST(stream);
+	CPPUNIT_TEST(reproducible);
+	CPPUNIT_TEST(delta);
+	CPPUNIT_TEST(async);
+	CPPUNIT_TEST(select_carries_fitness);
+	CPPUNIT_TEST(batch_unknown);
+	CPPUNIT_TEST(custom_selection);
+	CPPUNIT_TEST(pareto_selection);
 	CPPUNIT_TEST_SUITE_END();
 
 	protected:
@@ -1322,6 +3330,339 @@ class StreamTest : public CPPUNIT_NS::TestFixture
 
 			CPPUNIT_ASSERT(mean1 > mean2);
 		}
+
+		void reproducible()
+		{
+			Routes routes;
+
+			std::generate_n(std::back_inserter(routes), 100, []()
+			{
+				Route route;
+
+				ea::random::fill_distinct_n_int(std::back_inserter(route), 10, 0, 9);
+
+				return route;
+			});
+
+			auto run = [&routes](const int threads)
+			{
+#ifdef _OPENMP
+				omp_set_num_threads(threads);
+#endif
+				auto stream = ea::stream::make_immutable(begin(routes), end(routes), 42);
+
+				for(int i = 1; i <= 3; ++i)
+				{
+					stream = stream.select(ea::selection::DoubleTournament<std::less<double>>(), 20, euclidean_distance)
+					               .crossover(ea::crossover::PMX<Route>())
+					               .mutate(ea::mutation::DoubleSwap(), 0.5);
+				}
+
+				Routes result;
+
+				stream.take(std::back_inserter(result));
+
+				return result;
+			};
+
+			const Routes a = run(1);
+			const Routes b = run(4);
+
+#ifdef _OPENMP
+			omp_set_num_threads(omp_get_num_procs());
+#endif
+
+			CPPUNIT_ASSERT(!a.empty());
+			CPPUNIT_ASSERT(a == b);
+		}
+
+		void delta()
+		{
+			Routes routes(100, Route(10));
+
+			ea::init::permutations(begin(routes), end(routes));
+
+			std::atomic<size_t> evaluations(0);
+			std::atomic<size_t> deltas(0);
+			const WeightedSum fitness = { &evaluations, &deltas };
+
+			auto stream = ea::stream::make_immutable(begin(routes), end(routes), 42).evaluate(fitness);
+
+			CPPUNIT_ASSERT_EQUAL(size_t(100), evaluations.load());
+
+			stream = stream.mutate(ea::mutation::DoubleSwap(), 0.5, fitness)
+			               .mutate(ea::mutation::SingleSwap(), 0.5, fitness);
+
+			CPPUNIT_ASSERT_EQUAL(size_t(100), evaluations.load());
+			CPPUNIT_ASSERT(deltas > 0);
+
+			const auto values = stream.fitness_values();
+			size_t i = 0;
+
+			for(auto route = begin(stream); route != end(stream); ++route, ++i)
+			{
+				Route copy(*route);
+
+				CPPUNIT_ASSERT_EQUAL(fitness(begin(copy), end(copy)), values[i]);
+			}
+
+			evaluations = 0;
+
+			// mutations without delta support invalidate values:
+			stream = stream.mutate(ea::mutation::SingleBitString(), 0.5);
+
+			const auto invalidated = stream.fitness_values();
+			const auto unknown = std::count_if(begin(invalidated), end(invalidated), [](double v) { return std::isnan(v); });
+
+			CPPUNIT_ASSERT(unknown > 0);
+
+			Routes selected;
+
+			stream.select(ea::selection::Fittest<>(), 10, fitness).take(std::back_inserter(selected));
+
+			CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(unknown), evaluations.load());
+			CPPUNIT_ASSERT_EQUAL(size_t(10), selected.size());
+		}
+
+		void async()
+		{
+			Routes routes(20, Route(10));
+
+			ea::init::permutations(begin(routes), end(routes));
+
+			std::atomic<size_t> evaluations(0);
+			std::atomic<size_t> deltas(0);
+			const WeightedSum fitness = { &evaluations, &deltas };
+
+			auto run = [&](auto evaluator)
+			{
+				auto stream = ea::stream::make_immutable(begin(routes), end(routes), 7)
+					.crossover(ea::crossover::PMX<Route>(), evaluator)
+					.mutate(ea::mutation::SingleSwap(), 0.3, evaluator);
+
+				return std::make_tuple(Routes(stream.begin(), stream.end()), stream.fitness_values());
+			};
+
+			const auto [a, values_a] = run(fitness);
+			const auto [b, values_b] = run(ea::fitness::async(fitness, 3));
+
+			CPPUNIT_ASSERT(a == b);
+			CPPUNIT_ASSERT(values_a == values_b);
+			CPPUNIT_ASSERT(std::none_of(begin(values_b), end(values_b), [](double v) { return std::isnan(v); }));
+
+			// evaluations started by crossover & mutation are reused by selection:
+			auto stream = ea::stream::make_immutable(begin(routes), end(routes), 7)
+				.crossover(ea::crossover::PMX<Route>(), ea::fitness::async(fitness, 3));
+
+			const size_t before = evaluations;
+			Routes selected;
+
+			stream.select(ea::selection::Fittest<>(), 10, fitness).take(std::back_inserter(selected));
+
+			CPPUNIT_ASSERT_EQUAL(before, evaluations.load());
+			CPPUNIT_ASSERT_EQUAL(size_t(10), selected.size());
+		}
+
+		void select_carries_fitness()
+		{
+			Routes routes(100, Route(10));
+
+			ea::init::permutations(begin(routes), end(routes));
+
+			std::atomic<size_t> evaluations(0);
+			std::atomic<size_t> deltas(0);
+			const WeightedSum fitness = { &evaluations, &deltas };
+
+			auto stream = ea::stream::make_mutable(begin(routes), end(routes), 42)
+				.evaluate(fitness)
+				.select(ea::selection::Tournament<>(2), 50, fitness)
+				.select(ea::selection::Fittest<>(), 10, fitness);
+
+			CPPUNIT_ASSERT_EQUAL(size_t(100), evaluations.load());
+
+			const auto values = stream.fitness_values();
+			size_t i = 0;
+
+			CPPUNIT_ASSERT_EQUAL(size_t(10), values.size());
+
+			for(auto route = begin(stream); route != end(stream); ++route, ++i)
+			{
+				Route copy(*route);
+
+				CPPUNIT_ASSERT_EQUAL(fitness(begin(copy), end(copy)), values[i]);
+			}
+
+			CPPUNIT_ASSERT(std::is_sorted(begin(values), end(values), std::greater<double>()));
+		}
+
+		void batch_unknown()
+		{
+			Routes routes(1000, Route(10));
+
+			ea::init::permutations(begin(routes), end(routes));
+
+			std::atomic<size_t> evaluations(0);
+			std::atomic<size_t> deltas(0);
+			const WeightedSum fitness = { &evaluations, &deltas };
+			std::mutex mutex;
+			std::vector<size_t> sizes;
+
+			auto batch = [&](Routes::iterator first, Routes::iterator last, double *out)
+			{
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+
+					sizes.push_back(std::distance(first, last));
+				}
+
+				ea::fitness::batch(fitness)(first, last, out);
+			};
+
+			auto stream = ea::stream::make_mutable(begin(routes), end(routes), 42)
+				.evaluate(batch)
+				.mutate(ea::mutation::SingleSwap(), 0.5);
+
+			const auto before = stream.fitness_values();
+			const size_t unknown = std::count_if(begin(before), end(before), [](double v) { return std::isnan(v); });
+
+			CPPUNIT_ASSERT(unknown > ea::fitness::BATCH_SIZE);
+
+			sizes.clear();
+			stream = stream.evaluate(batch);
+
+			// unknown individuals are passed in full batches, not one by one:
+			CPPUNIT_ASSERT_EQUAL((unknown + ea::fitness::BATCH_SIZE - 1) / ea::fitness::BATCH_SIZE, sizes.size());
+			CPPUNIT_ASSERT_EQUAL(unknown, std::accumulate(begin(sizes), end(sizes), size_t(0)));
+
+			const auto values = stream.fitness_values();
+			size_t i = 0;
+
+			for(auto route = begin(stream); route != end(stream); ++route, ++i)
+			{
+				Route copy(*route);
+
+				CPPUNIT_ASSERT_EQUAL(fitness(begin(copy), end(copy)), values[i]);
+			}
+		}
+
+		void custom_selection()
+		{
+			Routes routes(100, Route(10));
+
+			ea::init::permutations(begin(routes), end(routes));
+
+			std::atomic<size_t> evaluations(0);
+			std::atomic<size_t> deltas(0);
+			const WeightedSum fitness = { &evaluations, &deltas };
+
+			// operators without FitnessTable support receive the fitness function, even if values are stored:
+			Routes selected;
+
+			ea::stream::make_immutable(begin(routes), end(routes), 42)
+				.evaluate(fitness)
+				.select(FirstByFitness(), 10, fitness)
+				.take(std::back_inserter(selected));
+
+			CPPUNIT_ASSERT_EQUAL(size_t(10), selected.size());
+
+			const double best = std::get<1>(ea::fitness::fittest(begin(routes), end(routes), fitness));
+			Route first = selected.front();
+
+			CPPUNIT_ASSERT_EQUAL(best, fitness(begin(first), end(first)));
+		}
+
+		void pareto_selection()
+		{
+			Routes routes(100, Route(10));
+
+			ea::init::permutations(begin(routes), end(routes));
+
+			auto objectives = [](Route::iterator first, Route::iterator last)
+			{
+				return ea::pareto::Objectives({ static_cast<double>(*first), static_cast<double>(*(last - 1)) });
+			};
+
+			std::atomic<size_t> evaluations(0);
+			std::atomic<size_t> deltas(0);
+			const WeightedSum fitness = { &evaluations, &deltas };
+
+			static_assert(ea::pareto::is_objective_function_v<decltype(objectives), Route::iterator>);
+			static_assert(!ea::pareto::is_objective_function_v<WeightedSum, Route::iterator>);
+
+			// stored scalar fitness values aren't passed to multi-objective operators:
+			Routes a;
+			Routes b;
+
+			ea::stream::make_immutable(begin(routes), end(routes), 42)
+				.select(ea::selection::ParetoTournament<>(2), 20, objectives)
+				.take(std::back_inserter(a));
+
+			ea::stream::make_immutable(begin(routes), end(routes), 42)
+				.evaluate(fitness)
+				.select(ea::selection::ParetoTournament<>(2), 20, objectives)
+				.take(std::back_inserter(b));
+
+			CPPUNIT_ASSERT_EQUAL(size_t(20), a.size());
+			CPPUNIT_ASSERT(a == b);
+		}
+
+	private:
+		// selection operator written without knowing about FitnessTable
+		struct FirstByFitness
+		{
+			template<typename InputIterator, typename Fitness, typename OutputIterator>
+			void operator()(InputIterator first, InputIterator last, const size_t N, Fitness fitness, OutputIterator result) const
+			{
+				std::vector<std::pair<double, InputIterator>> ranked;
+
+				for(auto it = first; it != last; ++it)
+				{
+					ranked.emplace_back(fitness(std::begin(*it), std::end(*it)), it);
+				}
+
+				std::stable_sort(begin(ranked), end(ranked), [](const auto &a, const auto &b)
+				{
+					return a.first > b.first;
+				});
+
+				for(size_t i = 0; i < N; ++i)
+				{
+					*result++ = *ranked[i].second;
+				}
+			}
+		};
+
+		struct WeightedSum
+		{
+			std::atomic<size_t> *evaluations;
+			std::atomic<size_t> *deltas;
+
+			double operator()(Route::iterator first, Route::iterator last) const
+			{
+				double f = 0.0;
+
+				for(auto it = first; it != last; ++it)
+				{
+					f += (std::distance(first, it) + 1) * *it;
+				}
+
+				++*evaluations;
+
+				return f;
+			}
+
+			double delta(Route::iterator first, Route::iterator, const std::vector<ea::fitness::Change<City>> &changes, double f) const
+			{
+				for(auto &change : changes)
+				{
+					f += static_cast<double>(change.offset + 1) * (first[change.offset] - change.value);
+				}
+
+				++*deltas;
+
+				return f;
+			}
+		};
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(StreamTest);